@@ -0,0 +1,52 @@
+#include "allocations.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long long> allocationCount{0};
+static std::atomic<long long> allocationBytes{0};
+static thread_local bool ignored = false;
+
+long long heapAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+long long heapAllocationBytes() {
+    return allocationBytes.load(std::memory_order_relaxed);
+}
+
+void ignoreThreadAllocations() {
+    ignored = true;
+}
+
+// Reemplazo global de operator new que solo cuenta y delega en malloc
+void* operator new(std::size_t size) {
+    if (!ignored) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
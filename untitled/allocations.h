@@ -0,0 +1,19 @@
+#pragma once
+
+// Numero total de reservas hechas con operator new desde el arranque
+// (todos los hilos). Restando dos lecturas se sabe si un tramo reservo memoria.
+long long heapAllocationCount();
+long long heapAllocationBytes();
+
+// Los hilos de carga reservan por su cuenta, fuera del presupuesto del
+// frame: despues de llamar esto sus reservas ya no se cuentan
+void ignoreThreadAllocations();
+
+// Reservas hechas desde `mark`; deja `mark` en la cuenta actual para
+// medir tramos seguidos (entrada, update, render)
+inline int allocationsSince(long long& mark) {
+    long long now = heapAllocationCount();
+    int count = static_cast<int>(now - mark);
+    mark = now;
+    return count;
+}
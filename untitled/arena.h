@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Arena de frame: asignacion por incremento de puntero y se vacia
+// completa al inicio de cada frame. Para datos que no sobreviven al frame.
+struct FrameArena {
+    std::vector<unsigned char> memory;
+    size_t offset = 0;
+    size_t peak = 0;
+    int failed = 0;
+};
+
+inline void initFrameArena(FrameArena& arena, size_t capacity) {
+    arena.memory.assign(capacity, 0);
+    arena.offset = 0;
+    arena.peak = 0;
+    arena.failed = 0;
+}
+
+inline void resetFrameArena(FrameArena& arena) {
+    arena.offset = 0;
+}
+
+inline void* arenaAlloc(FrameArena& arena, size_t size, size_t align) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(arena.memory.data());
+    size_t start = ((base + arena.offset + align - 1) & ~(static_cast<uintptr_t>(align) - 1)) - base;
+    if (start + size > arena.memory.size()) {
+        arena.failed++;
+        return nullptr;
+    }
+    arena.offset = start + size;
+    if (arena.offset > arena.peak) {
+        arena.peak = arena.offset;
+    }
+    return arena.memory.data() + start;
+}
+
+template <typename T>
+T* arenaAllocArray(FrameArena& arena, size_t count) {
+    return static_cast<T*>(arenaAlloc(arena, sizeof(T) * count, alignof(T)));
+}
@@ -0,0 +1,442 @@
+#include "asset_pack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+Uint32 hashAssetName(const char* name) {
+    Uint32 hash = 2166136261u;
+    for (; *name; ++name) {
+        hash ^= static_cast<unsigned char>(*name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool sectionFits(Uint64 fileSize, Uint64 offset, Uint64 bytes) {
+    return offset <= fileSize && bytes <= fileSize - offset;
+}
+
+bool openAssetPack(AssetPack& pack, const char* path) {
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN) {
+        std::cerr << "Asset packs are little-endian; this platform is not supported" << std::endl;
+        return false;
+    }
+    if (!mapFile(pack.file, path, false)) {
+        std::cerr << "Error opening asset pack " << path << std::endl;
+        return false;
+    }
+
+    // Todo se valida al abrir; despues las busquedas no comprueban nada
+    const PackHeader* header = reinterpret_cast<const PackHeader*>(pack.file.data);
+    Uint64 size = pack.file.size;
+    bool valid = size >= sizeof(PackHeader) &&
+                 header->magic == PACK_MAGIC &&
+                 header->version == PACK_VERSION &&
+                 header->headerSize == sizeof(PackHeader) &&
+                 header->fileSize == size &&
+                 header->blockSize > 0 && header->blockSize <= 0x1000000 &&
+                 header->tableSize > header->entryCount &&
+                 (header->tableSize & (header->tableSize - 1)) == 0 &&
+                 header->entriesOffset % 8 == 0 &&
+                 header->tableOffset % 4 == 0 &&
+                 sectionFits(size, header->entriesOffset, static_cast<Uint64>(header->entryCount) * sizeof(PackEntry)) &&
+                 sectionFits(size, header->tableOffset, static_cast<Uint64>(header->tableSize) * sizeof(Uint32));
+    if (valid) {
+        const PackEntry* entries = reinterpret_cast<const PackEntry*>(pack.file.data + header->entriesOffset);
+        const Uint32* table = reinterpret_cast<const Uint32*>(pack.file.data + header->tableOffset);
+        // Sin casillas vacias el sondeo de un nombre ausente no terminaria
+        Uint32 empty = 0;
+        for (Uint32 i = 0; valid && i < header->tableSize; ++i) {
+            valid = table[i] <= header->entryCount;
+            empty += table[i] == 0;
+        }
+        valid = valid && empty > 0;
+        for (Uint32 i = 0; valid && i < header->entryCount; ++i) {
+            const PackEntry& e = entries[i];
+            Uint64 blocks = (e.size + header->blockSize - 1) / header->blockSize;
+            valid = std::memchr(e.name, 0, PACK_NAME_SIZE) != nullptr &&
+                    e.offset % PACK_ALIGNMENT == 0 &&
+                    sectionFits(size, e.offset, e.storedSize) &&
+                    ((e.flags & PACK_ENTRY_COMPRESSED) ? e.blockCount == blocks && e.storedSize >= blocks * sizeof(Uint32)
+                                                       : e.storedSize == e.size);
+        }
+        pack.entries = entries;
+        pack.table = table;
+    }
+    if (!valid) {
+        std::cerr << "Invalid or unsupported asset pack " << path << std::endl;
+        closeAssetPack(pack);
+        return false;
+    }
+    pack.header = header;
+    pack.path = path;
+    return true;
+}
+
+void closeAssetPack(AssetPack& pack) {
+    unmapFile(pack.file);
+    pack = AssetPack();
+}
+
+const PackEntry* findAsset(const AssetPack& pack, const char* name) {
+    if (!pack.header) {
+        return nullptr;
+    }
+    Uint32 hash = hashAssetName(name);
+    Uint32 mask = pack.header->tableSize - 1;
+    // openAssetPack exige casillas vacias; el limite de tableSize pasos es
+    // solo un seguro extra
+    Uint32 slot = hash & mask;
+    for (Uint32 probe = 0; probe < pack.header->tableSize; ++probe, slot = (slot + 1) & mask) {
+        Uint32 index = pack.table[slot];
+        if (index == 0) {
+            return nullptr;
+        }
+        const PackEntry& entry = pack.entries[index - 1];
+        if (entry.hash == hash && std::strcmp(entry.name, name) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const unsigned char* assetData(const AssetPack& pack, const PackEntry& entry, std::vector<unsigned char>& scratch) {
+    if (!(entry.flags & PACK_ENTRY_COMPRESSED)) {
+        return pack.file.data + entry.offset;
+    }
+    scratch.resize(entry.size);
+    return readAsset(pack, entry, 0, entry.size, scratch.data()) ? scratch.data() : nullptr;
+}
+
+bool readAsset(const AssetPack& pack, const PackEntry& entry, Uint64 offset, Uint64 bytes, void* dst) {
+    if (offset > entry.size || bytes > entry.size - offset) {
+        return false;
+    }
+    const unsigned char* base = pack.file.data + entry.offset;
+    unsigned char* out = static_cast<unsigned char*>(dst);
+    if (!(entry.flags & PACK_ENTRY_COMPRESSED)) {
+        std::memcpy(out, base + offset, bytes);
+        return true;
+    }
+    if (bytes == 0) {
+        return true;
+    }
+
+    Uint64 blockSize = pack.header->blockSize;
+    const Uint32* ends = reinterpret_cast<const Uint32*>(base);
+    const unsigned char* blocks = base + entry.blockCount * sizeof(Uint32);
+    Uint64 available = entry.storedSize - entry.blockCount * sizeof(Uint32);
+    std::vector<unsigned char> partial; // Solo para los bloques de los bordes del rango
+    for (Uint64 k = offset / blockSize; k <= (offset + bytes - 1) / blockSize; ++k) {
+        Uint64 start = k > 0 ? ends[k - 1] : 0;
+        Uint64 end = ends[k];
+        if (start > end || end > available) {
+            return false;
+        }
+        Uint64 blockStart = k * blockSize;
+        Uint64 rawSize = std::min(blockSize, entry.size - blockStart);
+        Uint64 from = std::max(offset, blockStart) - blockStart;
+        Uint64 to = std::min(offset + bytes, blockStart + rawSize) - blockStart;
+        bool whole = from == 0 && to == rawSize;
+        unsigned char* decoded = out + (blockStart + from - offset);
+        if (!whole) {
+            partial.resize(rawSize);
+            decoded = partial.data();
+        }
+        // Un bloque que no se pudo comprimir se guarda tal cual
+        if (end - start == rawSize) {
+            std::memcpy(decoded, blocks + start, rawSize);
+        } else if (!lzDecompress(blocks + start, end - start, decoded, rawSize)) {
+            return false;
+        }
+        if (!whole) {
+            std::memcpy(out + (blockStart + from - offset), partial.data() + from, to - from);
+        }
+    }
+    return true;
+}
+
+// Tabla de bloques + bloques; vacio si comprimir no conviene
+static std::vector<unsigned char> compressEntry(const std::vector<unsigned char>& data, Uint32& blockCount) {
+    blockCount = static_cast<Uint32>((data.size() + PACK_BLOCK_SIZE - 1) / PACK_BLOCK_SIZE);
+    std::vector<unsigned char> stored(blockCount * sizeof(Uint32));
+    std::vector<unsigned char> block(lzCompressBound(PACK_BLOCK_SIZE));
+    Uint64 end = 0;
+    for (Uint32 k = 0; k < blockCount; ++k) {
+        const unsigned char* raw = data.data() + static_cast<size_t>(k) * PACK_BLOCK_SIZE;
+        size_t rawSize = std::min<size_t>(PACK_BLOCK_SIZE, data.size() - static_cast<size_t>(k) * PACK_BLOCK_SIZE);
+        size_t packed = lzCompress(raw, rawSize, block.data(), rawSize - 1);
+        if (packed > 0) {
+            stored.insert(stored.end(), block.data(), block.data() + packed);
+        } else {
+            stored.insert(stored.end(), raw, raw + rawSize);
+        }
+        end += packed > 0 ? packed : rawSize;
+        if (end > 0xFFFFFFFFu) {
+            return std::vector<unsigned char>();
+        }
+        Uint32 end32 = static_cast<Uint32>(end);
+        std::memcpy(stored.data() + k * sizeof(Uint32), &end32, sizeof(end32));
+    }
+    if (stored.size() > data.size() - data.size() / 8) {
+        return std::vector<unsigned char>();
+    }
+    return stored;
+}
+
+static Uint64 alignPack(Uint64 offset) {
+    return (offset + PACK_ALIGNMENT - 1) & ~static_cast<Uint64>(PACK_ALIGNMENT - 1);
+}
+
+// Rellena con ceros hasta `offset` y escribe la seccion
+static bool writeSection(std::FILE* file, Uint64& written, Uint64 offset, const void* data, size_t bytes) {
+    for (; written < offset; ++written) {
+        if (std::fputc(0, file) == EOF) {
+            return false;
+        }
+    }
+    written += bytes;
+    return bytes == 0 || std::fwrite(data, 1, bytes, file) == bytes;
+}
+
+bool writeAssetPack(const char* path, const std::vector<PackInput>& inputs) {
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN) {
+        std::cerr << "Asset packs are little-endian; this platform is not supported" << std::endl;
+        return false;
+    }
+
+    Uint32 count = static_cast<Uint32>(inputs.size());
+    Uint32 tableSize = 2;
+    while (tableSize < count * 2) {
+        tableSize *= 2;
+    }
+    PackHeader header = {};
+    header.magic = PACK_MAGIC;
+    header.version = PACK_VERSION;
+    header.headerSize = sizeof(PackHeader);
+    header.entryCount = count;
+    header.entriesOffset = sizeof(PackHeader);
+    header.tableOffset = header.entriesOffset + count * sizeof(PackEntry);
+    header.tableSize = tableSize;
+    header.blockSize = PACK_BLOCK_SIZE;
+
+    std::vector<PackEntry> entries(count);
+    std::vector<Uint32> table(tableSize, 0);
+    std::vector<std::vector<unsigned char>> stored(count);
+    Uint64 offset = alignPack(header.tableOffset + static_cast<Uint64>(tableSize) * sizeof(Uint32));
+    for (Uint32 i = 0; i < count; ++i) {
+        const PackInput& input = inputs[i];
+        PackEntry& e = entries[i];
+        if (input.name.empty() || input.name.size() >= PACK_NAME_SIZE) {
+            std::cerr << "Asset name must have 1 to " << PACK_NAME_SIZE - 1 << " characters: " << input.name << std::endl;
+            return false;
+        }
+        std::memcpy(e.name, input.name.c_str(), input.name.size() + 1);
+        e.hash = hashAssetName(e.name);
+        Uint32 mask = tableSize - 1;
+        Uint32 slot = e.hash & mask;
+        for (; table[slot] != 0; slot = (slot + 1) & mask) {
+            if (std::strcmp(entries[table[slot] - 1].name, e.name) == 0) {
+                std::cerr << "Duplicate asset " << e.name << std::endl;
+                return false;
+            }
+        }
+        table[slot] = i + 1;
+
+        if (input.compress && !input.data.empty()) {
+            stored[i] = compressEntry(input.data, e.blockCount);
+        }
+        if (!stored[i].empty()) {
+            e.flags = PACK_ENTRY_COMPRESSED;
+            e.storedSize = stored[i].size();
+        } else {
+            e.blockCount = 0;
+            e.storedSize = input.data.size();
+        }
+        e.size = input.data.size();
+        e.offset = offset;
+        offset = alignPack(offset + e.storedSize);
+    }
+    header.fileSize = offset;
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cerr << "Error creating " << path << std::endl;
+        return false;
+    }
+    Uint64 written = 0;
+    bool ok = writeSection(file, written, 0, &header, sizeof(header)) &&
+              writeSection(file, written, header.entriesOffset, entries.data(), entries.size() * sizeof(PackEntry)) &&
+              writeSection(file, written, header.tableOffset, table.data(), table.size() * sizeof(Uint32));
+    for (Uint32 i = 0; ok && i < count; ++i) {
+        const std::vector<unsigned char>& data = entries[i].flags & PACK_ENTRY_COMPRESSED ? stored[i] : inputs[i].data;
+        ok = writeSection(file, written, entries[i].offset, data.data(), data.size());
+    }
+    ok = ok && writeSection(file, written, header.fileSize, nullptr, 0);
+    if (std::fclose(file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        std::cerr << "Error writing " << path << std::endl;
+    }
+    return ok;
+}
+
+// Formato de LZ4: cada secuencia es un token (4 bits de largo de literales,
+// 4 bits de largo de copia - 4), los literales, la distancia de 2 bytes y la
+// extension de los largos en bytes de 255. La ultima secuencia solo tiene
+// literales. Como LZ4, los ultimos 5 bytes siempre van como literales.
+const int LZ_MIN_MATCH = 4;
+const int LZ_HASH_BITS = 12;
+const size_t LZ_MAX_DISTANCE = 65535;
+const size_t LZ_LAST_LITERALS = 5;
+const size_t LZ_MATCH_LIMIT = 12; // Ninguna copia empieza mas cerca del final
+
+size_t lzCompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+static Uint32 read32(const unsigned char* p) {
+    Uint32 v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static void writeLength(unsigned char*& op, size_t length) {
+    for (; length >= 255; length -= 255) {
+        *op++ = 255;
+    }
+    *op++ = static_cast<unsigned char>(length);
+}
+
+// matchLength == 0 es la ultima secuencia, solo literales
+static bool emitSequence(unsigned char*& op, const unsigned char* end, const unsigned char* literals, size_t literalCount,
+                         size_t distance, size_t matchLength) {
+    size_t needed = 1 + literalCount + literalCount / 255 + 1 + 2 + matchLength / 255 + 1;
+    if (needed > static_cast<size_t>(end - op)) {
+        return false;
+    }
+    size_t matchCode = matchLength > 0 ? matchLength - LZ_MIN_MATCH : 0;
+    unsigned char* token = op++;
+    *token = static_cast<unsigned char>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+    if (literalCount >= 15) {
+        writeLength(op, literalCount - 15);
+    }
+    std::memcpy(op, literals, literalCount);
+    op += literalCount;
+    if (matchLength > 0) {
+        *op++ = static_cast<unsigned char>(distance & 0xFF);
+        *op++ = static_cast<unsigned char>(distance >> 8);
+        if (matchCode >= 15) {
+            writeLength(op, matchCode - 15);
+        }
+    }
+    return true;
+}
+
+size_t lzCompress(const unsigned char* src, size_t size, unsigned char* dst, size_t capacity) {
+    // Ultima posicion vista de cada hash de 4 bytes
+    long long table[1 << LZ_HASH_BITS];
+    std::fill(table, table + (1 << LZ_HASH_BITS), -1LL);
+    unsigned char* op = dst;
+    const unsigned char* end = dst + capacity;
+    size_t anchor = 0;
+    size_t i = 0;
+    size_t matchLimit = size > LZ_MATCH_LIMIT ? size - LZ_MATCH_LIMIT : 0;
+    while (i < matchLimit) {
+        Uint32 sequence = read32(src + i);
+        Uint32 h = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        long long candidate = table[h];
+        table[h] = static_cast<long long>(i);
+        if (candidate < 0 || i - static_cast<size_t>(candidate) > LZ_MAX_DISTANCE || read32(src + candidate) != sequence) {
+            ++i;
+            continue;
+        }
+        size_t length = LZ_MIN_MATCH;
+        while (i + length < size - LZ_LAST_LITERALS && src[candidate + length] == src[i + length]) {
+            ++length;
+        }
+        if (!emitSequence(op, end, src + anchor, i - anchor, i - static_cast<size_t>(candidate), length)) {
+            return 0;
+        }
+        i += length;
+        anchor = i;
+    }
+    if (!emitSequence(op, end, src + anchor, size - anchor, 0, 0)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+static bool readLength(const unsigned char*& ip, const unsigned char* end, size_t& length) {
+    unsigned char b;
+    do {
+        if (ip == end) {
+            return false;
+        }
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+// Comprueba todos los limites: un bloque corrupto falla, no escribe fuera
+bool lzDecompress(const unsigned char* src, size_t size, unsigned char* dst, size_t dstSize) {
+    const unsigned char* ip = src;
+    const unsigned char* ipEnd = src + size;
+    unsigned char* op = dst;
+    unsigned char* opEnd = dst + dstSize;
+    while (ip < ipEnd) {
+        unsigned char token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(ip, ipEnd, literals)) {
+            return false;
+        }
+        if (literals > static_cast<size_t>(ipEnd - ip) || literals > static_cast<size_t>(opEnd - op)) {
+            return false;
+        }
+        // Copias de 16 bytes fijos cuando hay margen: lo que sobra se pisa despues
+        if (literals <= 16 && ipEnd - ip >= 16 && opEnd - op >= 16) {
+            std::memcpy(op, ip, 16);
+        } else {
+            std::memcpy(op, ip, literals);
+        }
+        ip += literals;
+        op += literals;
+        if (ip == ipEnd) {
+            break;
+        }
+
+        if (ipEnd - ip < 2) {
+            return false;
+        }
+        size_t distance = ip[0] | (ip[1] << 8);
+        ip += 2;
+        size_t length = token & 15;
+        if (length == 15 && !readLength(ip, ipEnd, length)) {
+            return false;
+        }
+        length += LZ_MIN_MATCH;
+        if (distance == 0 || distance > static_cast<size_t>(op - dst) || length > static_cast<size_t>(opEnd - op)) {
+            return false;
+        }
+        const unsigned char* match = op - distance;
+        if (distance >= 8 && static_cast<size_t>(opEnd - op) >= length + 8) {
+            // De a 8 bytes: con distancia >= 8 cada trozo ya esta escrito
+            for (size_t k = 0; k < length; k += 8) {
+                std::memcpy(op + k, match + k, 8);
+            }
+            op += length;
+        } else if (distance >= length) {
+            std::memcpy(op, match, length);
+            op += length;
+        } else {
+            // Copia solapada: repite el patron de `distance` bytes
+            for (size_t k = 0; k < length; ++k) {
+                *op++ = match[k];
+            }
+        }
+    }
+    return op == opEnd;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+
+const Uint32 PACK_MAGIC = 0x4B504B42;    // "BKPK" leido en little-endian
+const Uint32 PACK_VERSION = 1;
+const Uint32 PACK_ALIGNMENT = 64;        // Cada entrada empieza en una linea de cache
+const Uint32 PACK_BLOCK_SIZE = 64 * 1024; // Bloques comprimidos independientes
+const int PACK_NAME_SIZE = 64;
+
+// Paquete de assets: un solo archivo mapeado en lugar de muchos archivos
+// sueltos. Todo es little-endian.
+//   [cabecera][PackEntry x entryCount][tabla hash: Uint32 x tableSize][datos]
+// La tabla hash usa direccionamiento abierto con sondeo lineal; cada casilla
+// guarda indice + 1 de la entrada (0 = vacia). Las entradas sin comprimir se
+// usan tal cual desde el mapeo. Las comprimidas se parten en bloques de
+// PACK_BLOCK_SIZE comprimidos por separado, con una tabla al principio con
+// el final de cada bloque, asi se puede leer un rango sin descomprimir todo.
+struct PackHeader {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 headerSize;
+    Uint32 entryCount;
+    Uint32 entriesOffset;
+    Uint32 tableOffset;
+    Uint32 tableSize; // Potencia de dos, mayor que entryCount
+    Uint32 blockSize;
+    Uint64 fileSize;
+    Uint64 reserved;
+};
+static_assert(sizeof(PackHeader) == 48, "PackHeader layout is part of the file format");
+
+enum PackEntryFlags : Uint32 {
+    PACK_ENTRY_COMPRESSED = 1
+};
+
+struct PackEntry {
+    char name[PACK_NAME_SIZE]; // Ruta con '/', terminada en cero
+    Uint32 hash;               // FNV-1a del nombre
+    Uint32 flags;
+    Uint32 blockCount;         // Solo en las comprimidas
+    Uint32 reserved;
+    Uint64 offset;             // Alineado a PACK_ALIGNMENT
+    Uint64 size;               // Tamano original
+    Uint64 storedSize;         // Tamano en el paquete, con la tabla de bloques
+};
+static_assert(sizeof(PackEntry) == 104, "PackEntry layout is part of the file format");
+
+struct AssetPack {
+    MappedFile file;
+    std::string path; // Los niveles mapean el paquete otra vez con copia en escritura
+    const PackHeader* header = nullptr;
+    const PackEntry* entries = nullptr;
+    const Uint32* table = nullptr;
+};
+
+// Lo que recibe writeAssetPack por cada archivo
+struct PackInput {
+    std::string name;
+    std::vector<unsigned char> data;
+    bool compress = true; // Se guarda sin comprimir si no se gana al menos 1/8
+};
+
+Uint32 hashAssetName(const char* name);
+bool openAssetPack(AssetPack& pack, const char* path);
+void closeAssetPack(AssetPack& pack);
+const PackEntry* findAsset(const AssetPack& pack, const char* name);
+
+// Sin comprimir devuelve el puntero al mapeo, sin copiar; comprimida la
+// descomprime en `scratch`. nullptr si la entrada esta corrupta.
+const unsigned char* assetData(const AssetPack& pack, const PackEntry& entry, std::vector<unsigned char>& scratch);
+// Lee [offset, offset + bytes) descomprimiendo solo los bloques que toca
+bool readAsset(const AssetPack& pack, const PackEntry& entry, Uint64 offset, Uint64 bytes, void* dst);
+
+bool writeAssetPack(const char* path, const std::vector<PackInput>& inputs);
+
+// Compresion de bloques al estilo LZ4: secuencias de literales + copia con
+// distancia de 16 bits. lzCompress devuelve 0 si no entra en `capacity`.
+size_t lzCompressBound(size_t size);
+size_t lzCompress(const unsigned char* src, size_t size, unsigned char* dst, size_t capacity);
+bool lzDecompress(const unsigned char* src, size_t size, unsigned char* dst, size_t dstSize);
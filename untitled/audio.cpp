@@ -0,0 +1,345 @@
+#include "audio.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AUDIO_SSE2 1
+#endif
+
+AudioStats audioStats;
+
+// PCM mono en float, con ceros al final hasta un multiplo de 4 muestras
+struct Sample {
+    std::vector<float> pcm;
+};
+
+struct Voice {
+    const float* pcm;
+    int frames;
+    int position;
+    float left, right;
+    Uint32 id;
+};
+
+// Cola de ordenes: head lo mueve solo el juego y tail solo el callback
+struct AudioQueue {
+    alignas(64) std::atomic<Uint32> head{0};
+    alignas(64) std::atomic<Uint32> tail{0};
+    AudioCommand commands[AUDIO_QUEUE_SIZE];
+};
+
+typedef void (*MixVoiceFunc)(float* out, const float* in, int frames, float left, float right);
+
+static Sample samples[SOUND_COUNT];
+static AudioQueue queue;
+static Voice voices[MAX_AUDIO_VOICES]; // Las activas primero: [0, voiceCount)
+static int voiceCount = 0;
+static SDL_AudioDeviceID device = 0;
+// El dispositivo se puede abrir en otro hilo; el juego solo manda ordenes
+// despues de ver `running`
+static std::atomic<bool> running{false};
+static int frequency = AUDIO_FREQUENCY;
+static Uint32 nextVoiceId = 0;
+static Uint64 lastCallback = 0;
+
+// Tono con caida exponencial; la frecuencia va de `from` a `to`
+static void synthesize(Sample& sample, int rate, float seconds, float from, float to, float decay, bool square) {
+    int frames = static_cast<int>(seconds * rate);
+    sample.pcm.assign((frames + 3) & ~3, 0.0f);
+    float phase = 0.0f;
+    float attack = 0.002f * rate; // 2 ms de subida para que no haga clic
+    for (int i = 0; i < frames; ++i) {
+        float t = static_cast<float>(i) / frames;
+        phase += (from + (to - from) * t) / rate;
+        phase -= std::floor(phase);
+        float wave = square ? (phase < 0.5f ? 1.0f : -1.0f) : std::sin(phase * 6.2831853f);
+        sample.pcm[i] = 0.25f * wave * std::exp(-decay * t) * std::min(1.0f, i / attack);
+    }
+}
+
+static void createSamples(int rate) {
+    synthesize(samples[SOUND_HIT], rate, 0.06f, 880.0f, 660.0f, 6.0f, true);
+    synthesize(samples[SOUND_BOUNCE], rate, 0.09f, 440.0f, 520.0f, 5.0f, false);
+    synthesize(samples[SOUND_GAME_OVER], rate, 1.2f, 600.0f, 120.0f, 2.0f, true);
+}
+
+static void mixVoiceScalar(float* out, const float* in, int frames, float left, float right) {
+    for (int i = 0; i < frames; ++i) {
+        out[2 * i] += in[i] * left;
+        out[2 * i + 1] += in[i] * right;
+    }
+}
+
+#ifdef AUDIO_SSE2
+// Cuatro muestras mono por vuelta, intercaladas como dos pares L/R
+static void mixVoiceSse2(float* out, const float* in, int frames, float left, float right) {
+    __m128 gainLeft = _mm_set1_ps(left);
+    __m128 gainRight = _mm_set1_ps(right);
+    int i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 s = _mm_loadu_ps(in + i);
+        __m128 l = _mm_mul_ps(s, gainLeft);
+        __m128 r = _mm_mul_ps(s, gainRight);
+        _mm_storeu_ps(out + 2 * i, _mm_add_ps(_mm_loadu_ps(out + 2 * i), _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(out + 2 * i + 4, _mm_add_ps(_mm_loadu_ps(out + 2 * i + 4), _mm_unpackhi_ps(l, r)));
+    }
+    mixVoiceScalar(out + 2 * i, in + i, frames - i, left, right);
+}
+
+static MixVoiceFunc mixVoice = mixVoiceSse2;
+#else
+static MixVoiceFunc mixVoice = mixVoiceScalar;
+#endif
+
+static void clampMix(float* out, int count) {
+    int i = 0;
+#ifdef AUDIO_SSE2
+    __m128 low = _mm_set1_ps(-1.0f);
+    __m128 high = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_min_ps(high, _mm_max_ps(low, _mm_loadu_ps(out + i))));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = std::max(-1.0f, std::min(1.0f, out[i]));
+    }
+}
+
+// Paneo de potencia constante
+static void voiceGains(float volume, float pan, float& left, float& right) {
+    float angle = (std::max(-1.0f, std::min(1.0f, pan)) + 1.0f) * 0.25f * 3.14159265f;
+    left = volume * std::cos(angle);
+    right = volume * std::sin(angle);
+}
+
+static void bumpStat(std::atomic<Uint32>& stat) {
+    // Solo el callback lo escribe: no hace falta una operacion atomica completa
+    stat.store(stat.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+static void startVoice(const AudioCommand& command) {
+    int slot = voiceCount;
+    if (voiceCount == MAX_AUDIO_VOICES) {
+        // Sin voces libres se corta la mas vieja
+        slot = 0;
+        for (int v = 1; v < voiceCount; ++v) {
+            if (static_cast<Sint32>(voices[v].id - voices[slot].id) < 0) {
+                slot = v;
+            }
+        }
+        bumpStat(audioStats.stolenVoices);
+    } else {
+        voiceCount++;
+    }
+    const Sample& sample = samples[command.sound];
+    Voice& voice = voices[slot];
+    voice.pcm = sample.pcm.data();
+    voice.frames = static_cast<int>(sample.pcm.size());
+    voice.position = 0;
+    voice.id = command.voice;
+    voiceGains(command.volume, command.pan, voice.left, voice.right);
+}
+
+static void removeVoice(int v) {
+    voices[v] = voices[--voiceCount];
+}
+
+static void applyCommands() {
+    Uint32 tail = queue.tail.load(std::memory_order_relaxed);
+    Uint32 head = queue.head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+        const AudioCommand& command = queue.commands[tail & (AUDIO_QUEUE_SIZE - 1)];
+        if (command.type == AUDIO_PLAY) {
+            startVoice(command);
+        } else if (command.type == AUDIO_STOP) {
+            for (int v = 0; v < voiceCount; ++v) {
+                if (voices[v].id == command.voice) {
+                    removeVoice(v);
+                    break;
+                }
+            }
+        } else {
+            voiceCount = 0;
+        }
+    }
+    queue.tail.store(tail, std::memory_order_release);
+}
+
+// Mezcla `frames` frames estereo en `out`; las voces que terminan se quitan
+static void mixAudio(float* out, int frames) {
+    std::memset(out, 0, frames * 2 * sizeof(float));
+    for (int v = 0; v < voiceCount;) {
+        Voice& voice = voices[v];
+        int count = std::min(frames, voice.frames - voice.position);
+        mixVoice(out, voice.pcm + voice.position, count, voice.left, voice.right);
+        voice.position += count;
+        if (voice.position >= voice.frames) {
+            removeVoice(v);
+        } else {
+            ++v;
+        }
+    }
+    clampMix(out, frames * 2);
+}
+
+// Un callback que llega mas de dos buffers despues del anterior, o que
+// tarda mas que lo que dura su buffer, deja al dispositivo sin datos
+static void audioCallback(void*, Uint8* stream, int length) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    double toUs = 1e6 / static_cast<double>(SDL_GetPerformanceFrequency());
+    int frames = length / static_cast<int>(2 * sizeof(float));
+    double periodUs = frames * 1e6 / frequency;
+    if (lastCallback != 0 && (start - lastCallback) * toUs > periodUs * 2.0) {
+        bumpStat(audioStats.underruns);
+    }
+    lastCallback = start;
+
+    applyCommands();
+    mixAudio(reinterpret_cast<float*>(stream), frames);
+
+    Uint32 us = static_cast<Uint32>((SDL_GetPerformanceCounter() - start) * toUs);
+    if (us > periodUs) {
+        bumpStat(audioStats.underruns);
+    }
+    bumpStat(audioStats.callbacks);
+    audioStats.lastCallbackUs.store(us, std::memory_order_relaxed);
+    audioStats.totalCallbackUs.store(audioStats.totalCallbackUs.load(std::memory_order_relaxed) + us, std::memory_order_relaxed);
+    audioStats.maxCallbackUs.store(std::max(us, audioStats.maxCallbackUs.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    audioStats.voices.store(voiceCount, std::memory_order_relaxed);
+    audioStats.peakVoices.store(std::max(voiceCount, audioStats.peakVoices.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
+
+bool startAudio() {
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+        std::fprintf(stderr, "Error initializing audio: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_AudioSpec want = {};
+    want.freq = AUDIO_FREQUENCY;
+    want.format = AUDIO_F32SYS;
+    want.channels = 2;
+    want.samples = AUDIO_BUFFER_FRAMES;
+    want.callback = audioCallback;
+    SDL_AudioSpec have;
+    device = SDL_OpenAudioDevice(NULL, 0, &want, &have, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (!device) {
+        std::fprintf(stderr, "Error opening audio device: %s\n", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+    // El dispositivo esta pausado: nada corre en el callback todavia
+    frequency = have.freq;
+    createSamples(frequency);
+    voiceCount = 0;
+    lastCallback = 0;
+    queue.tail.store(queue.head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    SDL_PauseAudioDevice(device, 0);
+    running.store(true, std::memory_order_release);
+    return true;
+}
+
+void stopAudio() {
+    if (!device) {
+        return;
+    }
+    running.store(false, std::memory_order_relaxed);
+    SDL_CloseAudioDevice(device);
+    device = 0;
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+bool audioRunning() {
+    return running.load(std::memory_order_acquire);
+}
+
+static bool pushCommand(const AudioCommand& command) {
+    if (!running.load(std::memory_order_acquire)) {
+        return false;
+    }
+    Uint32 head = queue.head.load(std::memory_order_relaxed);
+    if (head - queue.tail.load(std::memory_order_acquire) == AUDIO_QUEUE_SIZE) {
+        audioStats.droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queue.commands[head & (AUDIO_QUEUE_SIZE - 1)] = command;
+    queue.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+Uint32 playSound(SoundId sound, float volume, float pan) {
+    if (++nextVoiceId == 0) {
+        nextVoiceId = 1;
+    }
+    return pushCommand({AUDIO_PLAY, sound, nextVoiceId, volume, pan}) ? nextVoiceId : 0;
+}
+
+void stopSound(Uint32 voice) {
+    pushCommand({AUDIO_STOP, SOUND_COUNT, voice, 0.0f, 0.0f});
+}
+
+void stopAllSounds() {
+    pushCommand({AUDIO_STOP_ALL, SOUND_COUNT, 0, 0.0f, 0.0f});
+}
+
+// Costo de mezclar un buffer con 64 y 128 voces, escalar contra SSE2, y
+// despues unos segundos con el dispositivo real. Sin SDL_AUDIODRIVER se usa
+// el driver dummy; con SDL_AUDIODRIVER=disk la salida queda en un archivo.
+void benchmarkAudio() {
+    const int voiceCounts[] = {64, MAX_AUDIO_VOICES};
+    const int buffers = 20000;
+    createSamples(AUDIO_FREQUENCY);
+    std::vector<float> buffer(AUDIO_BUFFER_FRAMES * 2);
+    double toNs = 1e9 / static_cast<double>(SDL_GetPerformanceFrequency());
+    double budgetNs = AUDIO_BUFFER_FRAMES * 1e9 / AUDIO_FREQUENCY;
+    MixVoiceFunc mixers[] = {mixVoiceScalar, mixVoice};
+    const char* mixerNames[] = {"scalar", mixVoice == mixVoiceScalar ? "scalar" : "sse2"};
+
+    std::printf("voices,mixer,ns_per_buffer,ns_per_voice_frame,budget_ns\n");
+    for (int count : voiceCounts) {
+        for (int m = 0; m < 2; ++m) {
+            MixVoiceFunc previous = mixVoice;
+            mixVoice = mixers[m];
+            double ns = 0.0;
+            for (int b = 0; b < buffers; ++b) {
+                // El sonido largo dura ~225 buffers: se reinician antes de que termine
+                if (b % 200 == 0) {
+                    voiceCount = 0;
+                    for (int v = 0; v < count; ++v) {
+                        startVoice({AUDIO_PLAY, SOUND_GAME_OVER, static_cast<Uint32>(v + 1), 0.5f, (v % 16) / 8.0f - 1.0f});
+                    }
+                }
+                Uint64 start = SDL_GetPerformanceCounter();
+                mixAudio(buffer.data(), AUDIO_BUFFER_FRAMES);
+                ns += (SDL_GetPerformanceCounter() - start) * toNs;
+            }
+            mixVoice = previous;
+            std::printf("%d,%s,%.0f,%.3f,%.0f\n", count, mixerNames[m], ns / buffers, ns / buffers / (count * AUDIO_BUFFER_FRAMES), budgetNs);
+        }
+    }
+    voiceCount = 0;
+
+    if (!SDL_getenv("SDL_AUDIODRIVER")) {
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    }
+    if (!startAudio()) {
+        return;
+    }
+    // Rafagas como las de una reaccion en cadena: 16 sonidos por frame
+    Uint32 seed = 12345;
+    for (int frame = 0; frame < 180; ++frame) {
+        for (int i = 0; i < 16; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            playSound(static_cast<SoundId>((seed >> 16) % SOUND_COUNT), 0.5f, ((seed >> 8) % 200) / 100.0f - 1.0f);
+        }
+        SDL_Delay(16);
+    }
+    stopAudio();
+    Uint32 callbacks = audioStats.callbacks.load();
+    std::printf("callbacks,avg_callback_us,max_callback_us,underruns,peak_voices,stolen_voices,dropped_commands\n");
+    std::printf("%u,%.1f,%u,%u,%d,%u,%u\n", callbacks, callbacks ? static_cast<double>(audioStats.totalCallbackUs.load()) / callbacks : 0.0,
+                audioStats.maxCallbackUs.load(), audioStats.underruns.load(), audioStats.peakVoices.load(),
+                audioStats.stolenVoices.load(), audioStats.droppedCommands.load());
+}
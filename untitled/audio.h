@@ -0,0 +1,61 @@
+#pragma once
+#include <SDL.h>
+#include <atomic>
+
+// Audio del juego. Los sonidos se generan una vez como PCM en memoria y
+// se mezclan en el callback de SDL. El hilo del juego manda las ordenes de
+// tocar y parar por una cola de un productor y un consumidor; el callback
+// nunca toma locks ni reserva memoria.
+const int AUDIO_FREQUENCY = 48000;
+const int AUDIO_BUFFER_FRAMES = 256;   // ~5 ms a 48 kHz
+const int MAX_AUDIO_VOICES = 128;
+const int AUDIO_QUEUE_SIZE = 256;      // Potencia de dos
+
+enum SoundId : Uint8 {
+    SOUND_HIT,       // Bloque golpeado
+    SOUND_BOUNCE,    // Rebote en el paddle
+    SOUND_GAME_OVER,
+    SOUND_COUNT
+};
+
+enum AudioCommandType : Uint8 {
+    AUDIO_PLAY,
+    AUDIO_STOP,
+    AUDIO_STOP_ALL
+};
+
+struct AudioCommand {
+    AudioCommandType type;
+    SoundId sound;
+    Uint32 voice;  // Id que devuelve playSound, para poder pararlo
+    float volume;
+    float pan;     // -1 izquierda, 1 derecha
+};
+
+// Lo escribe el callback; el juego lo lee para el titulo y los benchmarks
+struct AudioStats {
+    std::atomic<Uint32> callbacks{0};
+    std::atomic<Uint32> underruns{0};       // Callbacks tarde o que tardaron mas que el buffer
+    std::atomic<Uint32> lastCallbackUs{0};
+    std::atomic<Uint32> maxCallbackUs{0};
+    std::atomic<Uint64> totalCallbackUs{0};
+    std::atomic<int> voices{0};
+    std::atomic<int> peakVoices{0};
+    std::atomic<Uint32> stolenVoices{0};    // Voces cortadas para dar lugar a otra
+    std::atomic<Uint32> droppedCommands{0}; // Cola llena
+};
+
+extern AudioStats audioStats;
+
+// false si no hay dispositivo; el juego sigue sin sonido. Se puede llamar
+// desde otro hilo: hasta que termina playSound no hace nada.
+bool startAudio();
+void stopAudio(); // En el hilo del juego, despues de que startAudio termino
+bool audioRunning();
+
+// 0 si el audio no esta corriendo o la cola esta llena
+Uint32 playSound(SoundId sound, float volume = 1.0f, float pan = 0.0f);
+void stopSound(Uint32 voice);
+void stopAllSounds();
+
+void benchmarkAudio();
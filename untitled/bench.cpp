@@ -0,0 +1,55 @@
+#include "bench.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static double median(std::vector<double>& values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+}
+
+BenchResult summarizeBench(const char* name, int param, int iterations, std::vector<double>& samples, long long allocations) {
+    BenchResult result = {name, param, iterations, 0.0, 0.0, 0.0, 0.0, 0.0};
+    if (samples.empty()) {
+        return result;
+    }
+    result.medianNs = median(samples);
+    result.minNs = samples.front();
+    result.maxNs = samples.back();
+    std::vector<double> deviations(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        deviations[i] = std::fabs(samples[i] - result.medianNs);
+    }
+    result.madNs = median(deviations);
+    result.allocations = static_cast<double>(allocations) / (static_cast<double>(iterations) * samples.size());
+    return result;
+}
+
+void printBenchHeader() {
+    std::printf("%-28s %10s %10s %14s %12s %14s %8s\n", "case", "param", "iters", "median_ns", "mad_ns", "min_ns", "allocs");
+}
+
+void printBenchResult(const BenchResult& r) {
+    std::printf("%-28s %10d %10d %14.1f %12.1f %14.1f %8.2f\n", r.name, r.param, r.iterations, r.medianNs, r.madNs, r.minNs, r.allocations);
+    std::fflush(stdout);
+}
+
+bool writeBenchJson(const char* path, const std::vector<BenchResult>& results) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) {
+        std::fprintf(stderr, "Error opening %s\n", path);
+        return false;
+    }
+    std::fprintf(file, "{\n  \"warmup\": %d,\n  \"repetitions\": %d,\n  \"unit\": \"ns\",\n  \"results\": [\n", BENCH_WARMUP, BENCH_REPETITIONS);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::fprintf(file, "    {\"name\": \"%s\", \"param\": %d, \"iterations\": %d, \"median_ns\": %.3f, \"mad_ns\": %.3f,"
+                           " \"min_ns\": %.3f, \"max_ns\": %.3f, \"allocations\": %.3f}%s\n",
+                     r.name, r.param, r.iterations, r.medianNs, r.madNs, r.minNs, r.maxNs, r.allocations,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "allocations.h"
+
+// Microbenchmarks repetibles. Cada caso hace unas rondas de calentamiento
+// y despues varias repeticiones medidas; se reporta la mediana y la MAD
+// (desviacion absoluta mediana), que no se mueven por un par de rondas
+// lentas como si lo hacen el promedio y la desviacion estandar.
+const int BENCH_WARMUP = 3;
+const int BENCH_REPETITIONS = 15;
+
+struct BenchResult {
+    const char* name;
+    int param;          // Lo que varia entre casos: bloques, pelotas...
+    int iterations;     // Llamadas medidas por repeticion
+    double medianNs;    // Todos los tiempos son por llamada
+    double madNs;
+    double minNs;
+    double maxNs;
+    double allocations; // Reservas en el heap por llamada
+};
+
+BenchResult summarizeBench(const char* name, int param, int iterations, std::vector<double>& samples, long long allocations);
+void printBenchHeader();
+void printBenchResult(const BenchResult& result);
+bool writeBenchJson(const char* path, const std::vector<BenchResult>& results);
+
+// setup() prepara el estado y no se mide; run(i) se llama `iterations`
+// veces por repeticion
+template <typename Setup, typename Run>
+BenchResult runBench(const char* name, int param, int iterations, Setup&& setup, Run&& run) {
+    std::vector<double> samples;
+    samples.reserve(BENCH_REPETITIONS);
+    long long allocations = 0;
+    double toNs = 1e9 / static_cast<double>(SDL_GetPerformanceFrequency());
+    for (int r = 0; r < BENCH_WARMUP + BENCH_REPETITIONS; ++r) {
+        setup();
+        long long mark = heapAllocationCount();
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < iterations; ++i) {
+            run(i);
+        }
+        Uint64 end = SDL_GetPerformanceCounter();
+        if (r >= BENCH_WARMUP) {
+            samples.push_back((end - start) * toNs / iterations);
+            allocations += heapAllocationCount() - mark;
+        }
+    }
+    BenchResult result = summarizeBench(name, param, iterations, samples, allocations);
+    printBenchResult(result);
+    return result;
+}
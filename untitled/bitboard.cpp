@@ -0,0 +1,174 @@
+#include "bitboard.h"
+#include <cmath>
+#include <cstdio>
+
+void initBitboard(BitboardGrid& grid, int columns, int rows, int cellWidth, int cellHeight) {
+    grid.columns = columns;
+    grid.rows = rows;
+    grid.wordsPerRow = (columns + 63) / 64;
+    grid.cellWidth = cellWidth;
+    grid.cellHeight = cellHeight;
+    grid.bits.assign(grid.wordsPerRow * rows, ~0ull);
+
+    // Los bits sobrantes de la ultima palabra de cada fila quedan a cero
+    if (columns % 64 != 0) {
+        Uint64 lastMask = ~0ull >> (64 - columns % 64);
+        for (int r = 0; r < rows; ++r) {
+            grid.bits[r * grid.wordsPerRow + grid.wordsPerRow - 1] = lastMask;
+        }
+    }
+}
+
+int bitboardCount(const BitboardGrid& grid) {
+    int count = 0;
+    for (Uint64 word : grid.bits) {
+        count += popCount(word);
+    }
+    return count;
+}
+
+bool bitboardEmpty(const BitboardGrid& grid) {
+    Uint64 any = 0;
+    for (Uint64 word : grid.bits) {
+        any |= word;
+    }
+    return any == 0;
+}
+
+// Apaga el primer bloque que toca `area` y devuelve su rectangulo
+bool bitboardHit(BitboardGrid& grid, const SDL_Rect& area, SDL_Rect& hit) {
+    bool found = false;
+    forEachBitboardCell(grid, area, [&](int column, int row) {
+        if (found) {
+            return;
+        }
+        grid.bits[row * grid.wordsPerRow + column / 64] &= ~(1ull << (column % 64));
+        hit = bitboardCellRect(grid, column, row);
+        found = true;
+    });
+    return found;
+}
+
+// Mismas medidas que el juego
+static const float SIM_WIDTH = 640.0f;
+static const float SIM_HEIGHT = 480.0f;
+static const float SIM_BLOCK_WIDTH = 64.0f;
+static const float SIM_BLOCK_HEIGHT = 20.0f;
+static const float SIM_BALL_SIZE = 13.0f;
+static const float SIM_BALL_SPEED = 120.0f;
+static const float SIM_PADDLE_WIDTH = 100.0f;
+static const float SIM_PADDLE_Y = 450.0f;
+static const float SIM_PADDLE_SPEED = 200.0f;
+static const Uint64 STANDARD_FULL = (1ull << (STANDARD_COLUMNS * STANDARD_ROWS)) - 1;
+
+static void resetBall(BitboardGame& game, Uint32 seed) {
+    game.ballX = 110.0f + static_cast<float>(seed % 400);
+    game.ballY = 110.0f;
+    game.ballVX = (seed & 1) ? SIM_BALL_SPEED : -SIM_BALL_SPEED;
+    game.ballVY = SIM_BALL_SPEED;
+}
+
+void resetBitboardGame(BitboardGame& game, Uint32 seed) {
+    game.blocks = STANDARD_FULL;
+    resetBall(game, seed);
+    game.paddleX = SIM_WIDTH / 2 - SIM_PADDLE_WIDTH / 2;
+    game.score = 0;
+    game.lives = 3;
+    game.over = 0;
+}
+
+// Un paso de la misma logica que update(), con el paddle siguiendo la pelota
+void stepBitboardGame(BitboardGame& game, float dT) {
+    if (game.over) {
+        return;
+    }
+
+    float target = game.ballX + SIM_BALL_SIZE / 2 - SIM_PADDLE_WIDTH / 2;
+    float maxMove = SIM_PADDLE_SPEED * dT;
+    game.paddleX += std::max(-maxMove, std::min(maxMove, target - game.paddleX));
+    game.paddleX = std::max(0.0f, std::min(SIM_WIDTH - SIM_PADDLE_WIDTH, game.paddleX));
+
+    if (game.ballX < 0 || game.ballX + SIM_BALL_SIZE > SIM_WIDTH) {
+        game.ballVX = -game.ballVX;
+    }
+    if (game.ballY < 0) {
+        game.ballVY = -game.ballVY;
+    }
+    if (game.ballY + SIM_BALL_SIZE > SIM_HEIGHT) {
+        if (--game.lives == 0) {
+            game.over = 1;
+            return;
+        }
+        resetBall(game, game.blocks ^ game.score);
+    }
+
+    if (game.ballY + SIM_BALL_SIZE > SIM_PADDLE_Y && game.ballY < SIM_PADDLE_Y + 20.0f &&
+        game.ballX + SIM_BALL_SIZE > game.paddleX && game.ballX < game.paddleX + SIM_PADDLE_WIDTH) {
+        float relative = (game.ballX + SIM_BALL_SIZE / 2 - (game.paddleX + SIM_PADDLE_WIDTH / 2)) / (SIM_PADDLE_WIDTH / 2);
+        game.ballVX = SIM_BALL_SPEED * relative * 1.1f;
+        game.ballVY = -SIM_BALL_SPEED * std::cos(relative * static_cast<float>(M_PI) / 4) * 1.1f;
+        game.ballY = SIM_PADDLE_Y - SIM_BALL_SIZE;
+    }
+
+    // Bloques: mascara de las celdas que cubre la pelota y un AND
+    if (game.ballY < STANDARD_ROWS * SIM_BLOCK_HEIGHT) {
+        int c0 = std::max(0, static_cast<int>(game.ballX / SIM_BLOCK_WIDTH));
+        int c1 = std::min(STANDARD_COLUMNS - 1, static_cast<int>((game.ballX + SIM_BALL_SIZE - 1) / SIM_BLOCK_WIDTH));
+        int r0 = std::max(0, static_cast<int>(game.ballY / SIM_BLOCK_HEIGHT));
+        int r1 = std::min(STANDARD_ROWS - 1, static_cast<int>((game.ballY + SIM_BALL_SIZE - 1) / SIM_BLOCK_HEIGHT));
+        Uint64 columns = ((1ull << (c1 + 1)) - 1) & ~((1ull << c0) - 1);
+        Uint64 mask = 0;
+        for (int r = r0; r <= r1; ++r) {
+            mask |= columns << (r * STANDARD_COLUMNS);
+        }
+        Uint64 hit = game.blocks & mask;
+        if (hit) {
+            game.blocks ^= hit & (~hit + 1); // Apaga el bit mas bajo
+            game.score += 10;
+            game.ballVY = -game.ballVY;
+            if (game.blocks == 0) {
+                game.over = 1;
+            }
+        }
+    }
+
+    game.ballX += game.ballVX * dT;
+    game.ballY += game.ballVY * dT;
+}
+
+// Millones de partidas en paralelo sobre un arreglo compacto
+void benchmarkBitboard(int games, int steps) {
+    const float dT = 1.0f / 60.0f;
+
+    std::printf("layout,blocks,bitboard_bytes,block_table_bytes\n");
+    for (int scale : {1, 10, 142}) {
+        BitboardGrid grid;
+        initBitboard(grid, STANDARD_COLUMNS * scale, STANDARD_ROWS * scale, 64, 20);
+        std::printf("%dx%d,%d,%d,%d\n", grid.columns, grid.rows, bitboardCount(grid),
+                    static_cast<int>(grid.bits.size() * sizeof(Uint64)), grid.columns * grid.rows * 20);
+    }
+
+    std::vector<BitboardGame> worlds(games);
+    for (int i = 0; i < games; ++i) {
+        resetBitboardGame(worlds[i], static_cast<Uint32>(i) * 2654435761u);
+    }
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int s = 0; s < steps; ++s) {
+        for (auto& world : worlds) {
+            stepBitboardGame(world, dT);
+        }
+    }
+    double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+    long long blocksLeft = 0;
+    int finished = 0;
+    for (const auto& world : worlds) {
+        blocksLeft += popCount(world.blocks);
+        finished += world.over;
+    }
+    std::printf("worlds,bytes_per_world,total_mb,steps,ns_per_world_step,avg_blocks_left,finished\n");
+    std::printf("%d,%d,%.1f,%d,%.2f,%.2f,%d\n", games, static_cast<int>(sizeof(BitboardGame)),
+                games * sizeof(BitboardGame) / (1024.0 * 1024.0), steps,
+                seconds * 1e9 / (static_cast<double>(games) * steps),
+                static_cast<double>(blocksLeft) / games, finished);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <SDL.h>
+#include <algorithm>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+inline int countTrailingZeros(Uint64 x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+inline int popCount(Uint64 x) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// Nivel en rejilla regular guardado como bits: un bit por celda, filas de
+// `wordsPerRow` palabras de 64 bits. El nivel estandar de 5 x 10 cabe en
+// una sola palabra.
+struct BitboardGrid {
+    int columns = 0;
+    int rows = 0;
+    int wordsPerRow = 0;
+    int cellWidth = 0;
+    int cellHeight = 0;
+    std::vector<Uint64> bits;
+};
+
+void initBitboard(BitboardGrid& grid, int columns, int rows, int cellWidth, int cellHeight);
+int bitboardCount(const BitboardGrid& grid);
+bool bitboardEmpty(const BitboardGrid& grid);
+bool bitboardHit(BitboardGrid& grid, const SDL_Rect& area, SDL_Rect& hit);
+
+inline SDL_Rect bitboardCellRect(const BitboardGrid& grid, int column, int row) {
+    return {column * grid.cellWidth, row * grid.cellHeight, grid.cellWidth, grid.cellHeight};
+}
+
+// Llama a visit(columna, fila) por cada bit activo dentro de `area`,
+// saltando las celdas vacias de 64 en 64 con ctz.
+template <typename Visit>
+void forEachBitboardCell(const BitboardGrid& grid, const SDL_Rect& area, Visit&& visit) {
+    if (grid.columns == 0 || area.w <= 0 || area.h <= 0) {
+        return;
+    }
+    int c0 = std::max(0, area.x / grid.cellWidth);
+    int c1 = std::min(grid.columns - 1, (area.x + area.w - 1) / grid.cellWidth);
+    int r0 = std::max(0, area.y / grid.cellHeight);
+    int r1 = std::min(grid.rows - 1, (area.y + area.h - 1) / grid.cellHeight);
+    if (area.x + area.w <= 0 || area.y + area.h <= 0 || c0 > c1 || r0 > r1) {
+        return;
+    }
+    int w0 = c0 / 64, w1 = c1 / 64;
+    Uint64 firstMask = ~0ull << (c0 % 64);
+    Uint64 lastMask = ~0ull >> (63 - c1 % 64);
+    for (int r = r0; r <= r1; ++r) {
+        const Uint64* row = &grid.bits[r * grid.wordsPerRow];
+        for (int w = w0; w <= w1; ++w) {
+            Uint64 m = row[w];
+            if (w == w0) m &= firstMask;
+            if (w == w1) m &= lastMask;
+            while (m) {
+                visit(w * 64 + countTrailingZeros(m), r);
+                m &= m - 1;
+            }
+        }
+    }
+}
+
+// Partida completa del nivel estandar (5 x 10 bloques de 64 x 20 en una
+// pantalla de 640 x 480) en 32 bytes, para simular millones a la vez.
+const int STANDARD_COLUMNS = 10;
+const int STANDARD_ROWS = 5;
+
+struct BitboardGame {
+    Uint64 blocks;  // Bit fila * STANDARD_COLUMNS + columna
+    float ballX, ballY;
+    float ballVX, ballVY;
+    float paddleX;
+    Uint16 score;
+    Uint8 lives;
+    Uint8 over; // Gano o perdio
+};
+static_assert(sizeof(BitboardGame) == 32, "BitboardGame must stay at 32 bytes");
+
+void resetBitboardGame(BitboardGame& game, Uint32 seed);
+void stepBitboardGame(BitboardGame& game, float dT);
+void benchmarkBitboard(int games, int steps);
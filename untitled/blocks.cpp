@@ -0,0 +1,34 @@
+#include "blocks.h"
+#include <algorithm>
+
+static int cellOf(const BlockGrid& grid, const SDL_Rect& r) {
+    int cx = std::min(grid.columns - 1, std::max(0, r.x / GRID_CELL_WIDTH));
+    int cy = std::min(grid.rows - 1, std::max(0, r.y / GRID_CELL_HEIGHT));
+    return cy * grid.columns + cx;
+}
+
+void buildBlockGrid(BlockGrid& grid, const Block* blocks, int count, int worldWidth, int worldHeight) {
+    grid.columns = std::max(1, (worldWidth + GRID_CELL_WIDTH - 1) / GRID_CELL_WIDTH);
+    grid.rows = std::max(1, (worldHeight + GRID_CELL_HEIGHT - 1) / GRID_CELL_HEIGHT);
+    grid.maxBlockWidth = 0;
+    grid.maxBlockHeight = 0;
+    std::vector<int>& cellStart = grid.cellStartStorage;
+    cellStart.assign(grid.columns * grid.rows + 1, 0);
+    grid.itemsStorage.resize(count);
+
+    // Conteo por celda y suma prefija, luego reparto de indices
+    for (int i = 0; i < count; ++i) {
+        cellStart[cellOf(grid, blocks[i].rect) + 1]++;
+        grid.maxBlockWidth = std::max(grid.maxBlockWidth, blocks[i].rect.w);
+        grid.maxBlockHeight = std::max(grid.maxBlockHeight, blocks[i].rect.h);
+    }
+    for (size_t c = 1; c < cellStart.size(); ++c) {
+        cellStart[c] += cellStart[c - 1];
+    }
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < count; ++i) {
+        grid.itemsStorage[fill[cellOf(grid, blocks[i].rect)]++] = i;
+    }
+    grid.cellStart = cellStart.data();
+    grid.items = grid.itemsStorage.data();
+}
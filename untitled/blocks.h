@@ -0,0 +1,88 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include <algorithm>
+
+const int GRID_CELL_WIDTH = 256;
+const int GRID_CELL_HEIGHT = 128;
+
+// El formato binario de niveles guarda la tabla de bloques con esta misma
+// disposicion, por eso su tamano no puede cambiar
+struct Block {
+    SDL_Rect rect;
+    bool destroyed = false;
+};
+static_assert(sizeof(Block) == 20, "Block is stored as-is in level files");
+
+const int MAX_PALETTE_COLORS = 16;
+const int MAX_BLOCK_HIT_POINTS = 15;
+
+enum BlockType {
+    BLOCK_NORMAL,
+    BLOCK_UNBREAKABLE,
+    BLOCK_EXPLOSIVE,
+};
+
+// Atributos de cada bloque empaquetados en 16 bits, en una tabla paralela
+// para no engordar Block: vida (bits 0-3), tipo (4-5), color de paleta (6-9).
+typedef Uint16 BlockAttributes;
+
+inline BlockAttributes packBlockAttributes(int hitPoints, BlockType type, int palette) {
+    return static_cast<BlockAttributes>((hitPoints & 0xF) | (type << 4) | ((palette & 0xF) << 6));
+}
+
+inline int blockHitPoints(BlockAttributes a) {
+    return a & 0xF;
+}
+
+inline BlockType blockType(BlockAttributes a) {
+    return static_cast<BlockType>((a >> 4) & 0x3);
+}
+
+inline int blockPalette(BlockAttributes a) {
+    return (a >> 6) & 0xF;
+}
+
+inline void setBlockHitPoints(BlockAttributes& a, int hitPoints) {
+    a = static_cast<BlockAttributes>((a & ~0xF) | (hitPoints & 0xF));
+}
+
+// Rejilla espacial uniforme sobre los bloques, en formato compacto
+// (inicio de cada celda + indices). Cada bloque vive en la celda de su
+// esquina superior izquierda; las consultas se amplian por el bloque mas grande.
+// Los arreglos pueden venir de un archivo de nivel mapeado o de `storage`.
+struct BlockGrid {
+    int columns = 0;
+    int rows = 0;
+    int maxBlockWidth = 0;
+    int maxBlockHeight = 0;
+    const int* cellStart = nullptr; // columns * rows + 1
+    const int* items = nullptr;
+    std::vector<int> cellStartStorage;
+    std::vector<int> itemsStorage;
+};
+
+void buildBlockGrid(BlockGrid& grid, const Block* blocks, int count, int worldWidth, int worldHeight);
+
+// Llama a visit(indice) por cada bloque cuyo rectangulo puede tocar `area`.
+// Si visit devuelve true la consulta se detiene.
+template <typename Visit>
+void queryBlockGrid(const BlockGrid& grid, const SDL_Rect& area, Visit&& visit) {
+    if (grid.columns == 0) {
+        return;
+    }
+    int cx0 = std::max(0, (area.x - grid.maxBlockWidth) / GRID_CELL_WIDTH);
+    int cy0 = std::max(0, (area.y - grid.maxBlockHeight) / GRID_CELL_HEIGHT);
+    int cx1 = std::min(grid.columns - 1, (area.x + area.w) / GRID_CELL_WIDTH);
+    int cy1 = std::min(grid.rows - 1, (area.y + area.h) / GRID_CELL_HEIGHT);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            int cell = cy * grid.columns + cx;
+            for (int i = grid.cellStart[cell]; i < grid.cellStart[cell + 1]; ++i) {
+                if (visit(grid.items[i])) {
+                    return;
+                }
+            }
+        }
+    }
+}
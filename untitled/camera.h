@@ -0,0 +1,51 @@
+#pragma once
+#include <SDL.h>
+#include <cmath>
+#include <algorithm>
+
+const float MIN_CAMERA_ZOOM = 0.05f;
+const float MAX_CAMERA_ZOOM = 4.0f;
+
+// Camara 2D: (x, y) es el centro de la vista en coordenadas del mundo
+struct Camera {
+    float x = 0.0f;
+    float y = 0.0f;
+    float zoom = 1.0f;
+    int viewWidth = 0;  // Tamano de la pantalla en pixeles
+    int viewHeight = 0;
+};
+
+inline SDL_Rect cameraView(const Camera& camera) {
+    float w = camera.viewWidth / camera.zoom;
+    float h = camera.viewHeight / camera.zoom;
+    return {static_cast<int>(std::floor(camera.x - w / 2)), static_cast<int>(std::floor(camera.y - h / 2)),
+            static_cast<int>(std::ceil(w)) + 1, static_cast<int>(std::ceil(h)) + 1};
+}
+
+inline float worldToScreenX(const Camera& camera, float x) {
+    return (x - camera.x) * camera.zoom + camera.viewWidth / 2.0f;
+}
+
+inline float worldToScreenY(const Camera& camera, float y) {
+    return (y - camera.y) * camera.zoom + camera.viewHeight / 2.0f;
+}
+
+inline SDL_Rect worldToScreen(const Camera& camera, const SDL_Rect& r) {
+    int x0 = static_cast<int>(std::floor(worldToScreenX(camera, static_cast<float>(r.x))));
+    int y0 = static_cast<int>(std::floor(worldToScreenY(camera, static_cast<float>(r.y))));
+    int x1 = static_cast<int>(std::floor(worldToScreenX(camera, static_cast<float>(r.x + r.w))));
+    int y1 = static_cast<int>(std::floor(worldToScreenY(camera, static_cast<float>(r.y + r.h))));
+    return {x0, y0, std::max(1, x1 - x0), std::max(1, y1 - y0)};
+}
+
+// Sigue al objetivo suavemente sin salirse del mundo
+inline void followCamera(Camera& camera, float targetX, float targetY, int worldWidth, int worldHeight, float dT) {
+    float t = std::min(1.0f, dT * 5.0f);
+    camera.x += (targetX - camera.x) * t;
+    camera.y += (targetY - camera.y) * t;
+
+    float halfW = camera.viewWidth / camera.zoom / 2.0f;
+    float halfH = camera.viewHeight / camera.zoom / 2.0f;
+    camera.x = halfW * 2 >= worldWidth ? worldWidth / 2.0f : std::max(halfW, std::min(worldWidth - halfW, camera.x));
+    camera.y = halfH * 2 >= worldHeight ? worldHeight / 2.0f : std::max(halfH, std::min(worldHeight - halfH, camera.y));
+}
@@ -0,0 +1,321 @@
+#include "cpu_renderer.h"
+#include "profiler.h"
+#include <SDL_cpuinfo.h>
+#include <algorithm>
+#include <cstdio>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define CPU_RENDERER_SSE2 1
+#endif
+#if defined(CPU_RENDERER_SSE2) && defined(__GNUC__)
+#define CPU_RENDERER_AVX2 1
+#endif
+
+typedef void (*FillSpanFunc)(Uint32* dst, int count, Uint32 color);
+
+static void fillSpanScalar(Uint32* dst, int count, Uint32 color) {
+    for (int i = 0; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+#ifdef CPU_RENDERER_SSE2
+static void fillSpanSse2(Uint32* dst, int count, Uint32 color) {
+    __m128i c = _mm_set1_epi32(static_cast<int>(color));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), c);
+    }
+    for (; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+#endif
+
+#ifdef CPU_RENDERER_AVX2
+__attribute__((target("avx2")))
+static void fillSpanAvx2(Uint32* dst, int count, Uint32 color) {
+    __m256i c = _mm256_set1_epi32(static_cast<int>(color));
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), c);
+    }
+    for (; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+#endif
+
+static FillSpanFunc fillSpan = fillSpanScalar;
+
+static Uint32 packColor(SDL_Color c) {
+    return (static_cast<Uint32>(c.a) << 24) | (c.r << 16) | (c.g << 8) | c.b;
+}
+
+static void rasterizeTile(CpuRenderer& cpu, int tile) {
+    int tx = tile % cpu.tilesX;
+    int ty = tile / cpu.tilesX;
+    int x0 = tx * CPU_TILE_WIDTH;
+    int y0 = ty * CPU_TILE_HEIGHT;
+    int x1 = std::min(x0 + CPU_TILE_WIDTH, cpu.width);
+    int y1 = std::min(y0 + CPU_TILE_HEIGHT, cpu.height);
+
+    for (int y = y0; y < y1; ++y) {
+        fillSpan(reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(cpu.pixels) + y * cpu.pitch) + x0, x1 - x0, cpu.clearColor);
+    }
+
+    // Los rectangulos del tile en el orden en que se pidieron
+    for (int k = cpu.binStart[tile]; k < cpu.binStart[tile + 1]; ++k) {
+        const CpuRect& r = cpu.rects[cpu.binItems[k]];
+        int rx0 = std::max(r.rect.x, x0);
+        int ry0 = std::max(r.rect.y, y0);
+        int rx1 = std::min(r.rect.x + r.rect.w, x1);
+        int ry1 = std::min(r.rect.y + r.rect.h, y1);
+        for (int y = ry0; y < ry1; ++y) {
+            fillSpan(reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(cpu.pixels) + y * cpu.pitch) + rx0, rx1 - rx0, r.color);
+        }
+    }
+}
+
+static int runTiles(CpuRenderer& cpu) {
+    PROFILE_ZONE("rasterize");
+    int total = cpu.tilesX * cpu.tilesY;
+    int finished = 0;
+    for (int tile = cpu.nextTile.fetch_add(1); tile < total; tile = cpu.nextTile.fetch_add(1)) {
+        rasterizeTile(cpu, tile);
+        finished++;
+    }
+    return finished;
+}
+
+static void workerLoop(CpuRenderer* cpu) {
+    registerProfileThread("cpu worker");
+    int seen = 0;
+    std::unique_lock<std::mutex> lock(cpu->mutex);
+    while (true) {
+        cpu->wake.wait(lock, [&] { return cpu->quit || cpu->frame != seen; });
+        if (cpu->quit) {
+            return;
+        }
+        seen = cpu->frame;
+        lock.unlock();
+        int finished = runTiles(*cpu);
+        lock.lock();
+        cpu->tilesDone += finished;
+        if (cpu->tilesDone == cpu->tilesX * cpu->tilesY) {
+            cpu->done.notify_one();
+        }
+    }
+}
+
+bool initCpuRenderer(CpuRenderer& cpu, SDL_Renderer* renderer, int width, int height, int threads) {
+#ifdef CPU_RENDERER_AVX2
+    if (SDL_HasAVX2()) {
+        fillSpan = fillSpanAvx2;
+    } else
+#endif
+#ifdef CPU_RENDERER_SSE2
+    if (SDL_HasSSE2()) {
+        fillSpan = fillSpanSse2;
+    } else
+#endif
+    {
+        fillSpan = fillSpanScalar;
+    }
+
+    cpu.width = width;
+    cpu.height = height;
+    cpu.tilesX = (width + CPU_TILE_WIDTH - 1) / CPU_TILE_WIDTH;
+    cpu.tilesY = (height + CPU_TILE_HEIGHT - 1) / CPU_TILE_HEIGHT;
+    cpu.rects.reserve(CPU_MAX_RECTS);
+    cpu.binStart.assign(cpu.tilesX * cpu.tilesY + 1, 0);
+    cpu.binCursor.assign(cpu.tilesX * cpu.tilesY, 0);
+    cpu.binItems.reserve(CPU_MAX_BIN_ITEMS);
+
+    if (renderer) {
+        cpu.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (!cpu.texture) {
+            return false;
+        }
+    }
+
+    // El hilo principal tambien rasteriza, por eso uno menos
+    for (int i = 1; i < threads; ++i) {
+        cpu.workers.emplace_back(workerLoop, &cpu);
+    }
+    return true;
+}
+
+void destroyCpuRenderer(CpuRenderer& cpu) {
+    {
+        std::lock_guard<std::mutex> lock(cpu.mutex);
+        cpu.quit = true;
+    }
+    cpu.wake.notify_all();
+    for (auto& worker : cpu.workers) {
+        worker.join();
+    }
+    cpu.workers.clear();
+    if (cpu.texture) {
+        SDL_DestroyTexture(cpu.texture);
+        cpu.texture = nullptr;
+    }
+}
+
+void cpuClear(CpuRenderer& cpu, SDL_Color color) {
+    cpu.clearColor = packColor(color);
+    cpu.rects.clear();
+    cpu.binnedItems = 0;
+    cpu.dropped = 0;
+}
+
+void cpuFillRect(CpuRenderer& cpu, const SDL_Rect& rect, SDL_Color color) {
+    SDL_Rect screen = {0, 0, cpu.width, cpu.height};
+    SDL_Rect clipped;
+    if (!SDL_IntersectRect(&rect, &screen, &clipped)) {
+        return;
+    }
+    // Un rectangulo grande ocupa un lugar en cada tile que toca
+    int tiles = ((clipped.x + clipped.w - 1) / CPU_TILE_WIDTH - clipped.x / CPU_TILE_WIDTH + 1) *
+                ((clipped.y + clipped.h - 1) / CPU_TILE_HEIGHT - clipped.y / CPU_TILE_HEIGHT + 1);
+    if (static_cast<int>(cpu.rects.size()) == CPU_MAX_RECTS || cpu.binnedItems + tiles > CPU_MAX_BIN_ITEMS) {
+        cpu.dropped++;
+        return;
+    }
+    cpu.binnedItems += tiles;
+    cpu.rects.push_back({clipped, packColor(color)});
+}
+
+void cpuRasterize(CpuRenderer& cpu, Uint32* pixels, int pitch) {
+    PROFILE_ZONE("cpuRasterize");
+    // Repartir los rectangulos en los tiles que tocan: contar, acumular y
+    // llenar, conservando el orden de dibujo dentro de cada tile
+    int tiles = cpu.tilesX * cpu.tilesY;
+    std::fill(cpu.binStart.begin(), cpu.binStart.end(), 0);
+    for (const CpuRect& rect : cpu.rects) {
+        const SDL_Rect& r = rect.rect;
+        for (int ty = r.y / CPU_TILE_HEIGHT; ty <= (r.y + r.h - 1) / CPU_TILE_HEIGHT; ++ty) {
+            for (int tx = r.x / CPU_TILE_WIDTH; tx <= (r.x + r.w - 1) / CPU_TILE_WIDTH; ++tx) {
+                cpu.binStart[ty * cpu.tilesX + tx + 1]++;
+            }
+        }
+    }
+    for (int t = 0; t < tiles; ++t) {
+        cpu.binStart[t + 1] += cpu.binStart[t];
+        cpu.binCursor[t] = cpu.binStart[t];
+    }
+    cpu.binItems.resize(cpu.binStart[tiles]);
+    for (int i = 0; i < static_cast<int>(cpu.rects.size()); ++i) {
+        const SDL_Rect& r = cpu.rects[i].rect;
+        for (int ty = r.y / CPU_TILE_HEIGHT; ty <= (r.y + r.h - 1) / CPU_TILE_HEIGHT; ++ty) {
+            for (int tx = r.x / CPU_TILE_WIDTH; tx <= (r.x + r.w - 1) / CPU_TILE_WIDTH; ++tx) {
+                cpu.binItems[cpu.binCursor[ty * cpu.tilesX + tx]++] = i;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cpu.mutex);
+        cpu.pixels = pixels;
+        cpu.pitch = pitch;
+        cpu.nextTile = 0;
+        cpu.tilesDone = 0;
+        cpu.frame++;
+    }
+    cpu.wake.notify_all();
+
+    int finished = runTiles(cpu);
+
+    std::unique_lock<std::mutex> lock(cpu.mutex);
+    cpu.tilesDone += finished;
+    cpu.done.wait(lock, [&] { return cpu.tilesDone == cpu.tilesX * cpu.tilesY; });
+}
+
+void cpuPresent(CpuRenderer& cpu, SDL_Renderer* renderer) {
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(cpu.texture, NULL, &pixels, &pitch) == 0) {
+        cpuRasterize(cpu, static_cast<Uint32*>(pixels), pitch);
+        SDL_UnlockTexture(cpu.texture);
+    }
+    SDL_RenderCopy(renderer, cpu.texture, NULL, NULL);
+}
+
+// Escena de prueba: rejilla de bloques escalada a la resolucion y
+// un enjambre de rectangulos pequenos tipo particula
+static void buildBenchmarkScene(std::vector<CpuRect>& scene, int width, int height) {
+    scene.clear();
+    int blockW = width / 10;
+    int blockH = height / 24;
+    for (int row = 0; row < 5; ++row) {
+        for (int col = 0; col < 10; ++col) {
+            scene.push_back({{col * blockW - 1, row * blockH - 1, blockW + 2, blockH + 2}, 0xFF000000});
+            scene.push_back({{col * blockW, row * blockH, blockW, blockH}, 0xFF00FF00});
+        }
+    }
+    scene.push_back({{width / 2 - width / 12, height - height / 12, width / 6, height / 24}, 0xFFFFFFFF});
+    scene.push_back({{width / 3, height / 2, width / 50, width / 50}, 0xFFFF0000});
+    Uint32 seed = 12345;
+    for (int i = 0; i < 10000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        scene.push_back({{static_cast<int>((seed >> 4) % width), static_cast<int>((seed >> 16) % height), 2, 2}, 0xFFFFA020});
+    }
+}
+
+static SDL_Color unpackColor(Uint32 c) {
+    return {static_cast<Uint8>(c >> 16), static_cast<Uint8>(c >> 8), static_cast<Uint8>(c), static_cast<Uint8>(c >> 24)};
+}
+
+void benchmarkRenderers(int threads) {
+    const int sizes[][3] = {{640, 480, 240}, {3840, 2160, 30}};
+    std::vector<CpuRect> scene;
+
+    std::printf("backend,width,height,frame_ms,fps\n");
+    for (const auto& size : sizes) {
+        int width = size[0];
+        int height = size[1];
+        int frames = size[2];
+        buildBenchmarkScene(scene, width, height);
+
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!surface) {
+            continue;
+        }
+
+        // Renderer por software de SDL sobre la misma superficie
+        SDL_Renderer* software = SDL_CreateSoftwareRenderer(surface);
+        if (software) {
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (int f = 0; f < frames; ++f) {
+                SDL_SetRenderDrawColor(software, 0x00, 0x00, 0x00, 0xFF);
+                SDL_RenderClear(software);
+                for (const auto& r : scene) {
+                    SDL_Color c = unpackColor(r.color);
+                    SDL_SetRenderDrawColor(software, c.r, c.g, c.b, c.a);
+                    SDL_RenderFillRect(software, &r.rect);
+                }
+                SDL_RenderPresent(software);
+            }
+            float ms = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency() / frames;
+            std::printf("sdl-software,%d,%d,%.3f,%.1f\n", width, height, ms, 1000.0f / ms);
+            SDL_DestroyRenderer(software);
+        }
+
+        CpuRenderer cpu;
+        if (initCpuRenderer(cpu, NULL, width, height, threads)) {
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (int f = 0; f < frames; ++f) {
+                cpuClear(cpu, {0x00, 0x00, 0x00, 0xFF});
+                for (const auto& r : scene) {
+                    cpuFillRect(cpu, r.rect, unpackColor(r.color));
+                }
+                cpuRasterize(cpu, static_cast<Uint32*>(surface->pixels), surface->pitch);
+            }
+            float ms = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency() / frames;
+            std::printf("cpu,%d,%d,%.3f,%.1f\n", width, height, ms, 1000.0f / ms);
+        }
+        destroyCpuRenderer(cpu);
+
+        SDL_FreeSurface(surface);
+    }
+}
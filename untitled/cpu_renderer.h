@@ -0,0 +1,61 @@
+#pragma once
+#include <SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const int CPU_TILE_WIDTH = 128;
+const int CPU_TILE_HEIGHT = 64;
+const int CPU_MAX_RECTS = 131072; // Igual que MAX_RENDER_COMMANDS
+const int CPU_MAX_BIN_ITEMS = CPU_MAX_RECTS * 2; // Pares rectangulo-tile por frame
+
+struct CpuRect {
+    SDL_Rect rect;
+    Uint32 color; // ARGB8888
+};
+
+// Backend de rasterizado por CPU para maquinas sin GPU. Los rectangulos
+// del frame se reparten en tiles y cada tile se rellena en paralelo con
+// kernels SSE2/AVX2 directamente sobre el framebuffer destino.
+struct CpuRenderer {
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    Uint32 clearColor = 0xFF000000;
+    SDL_Texture* texture = nullptr;
+
+    // Rectangulos del frame y su reparto por tile en formato CSR: los del
+    // tile t son binItems[binStart[t], binStart[t + 1]). Se reservan al
+    // iniciar para que el frame no crezca ningun vector: cpuFillRect
+    // descarta lo que no entra en CPU_MAX_RECTS o en CPU_MAX_BIN_ITEMS.
+    std::vector<CpuRect> rects;
+    std::vector<int> binStart;
+    std::vector<int> binCursor;
+    std::vector<int> binItems;
+    int binnedItems = 0; // Pares rectangulo-tile del frame hasta ahora
+    int dropped = 0;     // Rectangulos descartados en el frame
+
+    // Destino del frame actual
+    Uint32* pixels = nullptr;
+    int pitch = 0;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::atomic<int> nextTile{0};
+    int tilesDone = 0;
+    int frame = 0;
+    bool quit = false;
+};
+
+bool initCpuRenderer(CpuRenderer& cpu, SDL_Renderer* renderer, int width, int height, int threads);
+void destroyCpuRenderer(CpuRenderer& cpu);
+void cpuClear(CpuRenderer& cpu, SDL_Color color);
+void cpuFillRect(CpuRenderer& cpu, const SDL_Rect& rect, SDL_Color color);
+void cpuRasterize(CpuRenderer& cpu, Uint32* pixels, int pitch);
+void cpuPresent(CpuRenderer& cpu, SDL_Renderer* renderer);
+void benchmarkRenderers(int threads);
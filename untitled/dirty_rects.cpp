@@ -0,0 +1,78 @@
+#include "dirty_rects.h"
+
+static int area(const SDL_Rect& r) {
+    return r.w * r.h;
+}
+
+void markDirty(DirtyRects& dirty, const SDL_Rect& rect) {
+    if (dirty.full || rect.w <= 0 || rect.h <= 0) {
+        return;
+    }
+    if (dirty.count == MAX_DIRTY_RECTS) {
+        // Sin espacio: se junta con el ultimo
+        SDL_UnionRect(&dirty.rects[dirty.count - 1], &rect, &dirty.rects[dirty.count - 1]);
+        return;
+    }
+    dirty.rects[dirty.count++] = rect;
+}
+
+void markDirtyMove(DirtyRects& dirty, const SDL_Rect& previous, const SDL_Rect& current) {
+    if (previous.x == current.x && previous.y == current.y && previous.w == current.w && previous.h == current.h) {
+        return;
+    }
+    markDirty(dirty, previous);
+    markDirty(dirty, current);
+}
+
+void markFullDirty(DirtyRects& dirty) {
+    dirty.full = true;
+}
+
+void mergeDirtyRects(DirtyRects& dirty, int width, int height) {
+    SDL_Rect screen = {0, 0, width, height};
+    if (dirty.full) {
+        dirty.rects[0] = screen;
+        dirty.count = 1;
+        dirty.pixels = width * height;
+        return;
+    }
+
+    // Recortar a la pantalla y descartar los vacios
+    int n = 0;
+    for (int i = 0; i < dirty.count; ++i) {
+        SDL_Rect clipped;
+        if (SDL_IntersectRect(&dirty.rects[i], &screen, &clipped)) {
+            dirty.rects[n++] = clipped;
+        }
+    }
+
+    // Juntar pares que se tocan o cuya union no desperdicia mucho area
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < n && !merged; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                SDL_Rect u;
+                SDL_UnionRect(&dirty.rects[i], &dirty.rects[j], &u);
+                if (SDL_HasIntersection(&dirty.rects[i], &dirty.rects[j]) ||
+                    area(u) <= area(dirty.rects[i]) + area(dirty.rects[j]) + 256) {
+                    dirty.rects[i] = u;
+                    dirty.rects[j] = dirty.rects[--n];
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    dirty.count = n;
+    dirty.pixels = 0;
+    for (int i = 0; i < n; ++i) {
+        dirty.pixels += area(dirty.rects[i]);
+    }
+}
+
+void clearDirtyRects(DirtyRects& dirty) {
+    dirty.count = 0;
+    dirty.full = false;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <SDL.h>
+
+const int MAX_DIRTY_RECTS = 32;
+
+// Regiones de pantalla que cambiaron desde el frame anterior. Solo esas
+// se vuelven a pintar y a presentar (util en VNC o superficies por software).
+struct DirtyRects {
+    SDL_Rect rects[MAX_DIRTY_RECTS];
+    int count = 0;
+    bool full = true;
+    int pixels = 0;
+};
+
+void markDirty(DirtyRects& dirty, const SDL_Rect& rect);
+void markDirtyMove(DirtyRects& dirty, const SDL_Rect& previous, const SDL_Rect& current);
+void markFullDirty(DirtyRects& dirty);
+void mergeDirtyRects(DirtyRects& dirty, int width, int height);
+void clearDirtyRects(DirtyRects& dirty);
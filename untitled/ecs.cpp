@@ -0,0 +1,212 @@
+#include "ecs.h"
+#include "profiler.h"
+#include <cstring>
+
+static const int COMPONENT_SIZES[COMPONENT_COUNT] = {
+    sizeof(Position), sizeof(Velocity), sizeof(Size), sizeof(SDL_Color), sizeof(Uint8), 0, 0, 0, 0,
+};
+static const int COLUMN_ALIGNMENT = 64;
+
+static int alignColumn(int offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+}
+
+// Columnas del arquetipo dentro del chunk para `capacity` entidades.
+// Devuelve los bytes usados.
+static int layoutArchetype(Archetype& archetype, int capacity) {
+    int offset = alignColumn(capacity * static_cast<int>(sizeof(Entity)));
+    for (int c = 0; c < COMPONENT_COUNT; ++c) {
+        archetype.offsets[c] = -1;
+        if ((archetype.mask & componentBit(static_cast<Component>(c))) && COMPONENT_SIZES[c] > 0) {
+            archetype.offsets[c] = offset;
+            // Una linea de mas entre columnas: si quedaran a multiplos exactos
+            // de 4 KB, leer una y escribir otra choca en el cache (4K aliasing)
+            offset = alignColumn(offset + capacity * COMPONENT_SIZES[c]) + COLUMN_ALIGNMENT;
+        }
+    }
+    return offset;
+}
+
+static int findArchetype(EntityWorld& world, ComponentMask mask) {
+    for (int a = 0; a < static_cast<int>(world.archetypes.size()); ++a) {
+        if (world.archetypes[a].mask == mask) {
+            return a;
+        }
+    }
+
+    // Tantas entidades por chunk como quepan en 16 KB con las columnas alineadas
+    Archetype archetype;
+    archetype.mask = mask;
+    int rowBytes = sizeof(Entity);
+    for (int c = 0; c < COMPONENT_COUNT; ++c) {
+        if (mask & componentBit(static_cast<Component>(c))) {
+            rowBytes += COMPONENT_SIZES[c];
+        }
+    }
+    int capacity = ECS_CHUNK_BYTES / rowBytes;
+    while (layoutArchetype(archetype, capacity) > ECS_CHUNK_BYTES) {
+        capacity--;
+    }
+    archetype.capacity = capacity;
+    world.archetypes.push_back(archetype);
+    return static_cast<int>(world.archetypes.size()) - 1;
+}
+
+void initEntityWorld(EntityWorld& world, int capacity) {
+    initHandlePool(world.handles, capacity);
+    world.locations.assign(capacity, {-1, 0, 0});
+    world.archetypes.clear();
+    world.archetypes.reserve(COMPONENT_COUNT * 4);
+    world.commands.clear();
+    world.commands.reserve(capacity);
+}
+
+// Crea el arquetipo y sus chunks por adelantado, para que las primeras
+// entidades de ese tipo no reserven memoria en medio del juego
+void reserveEntities(EntityWorld& world, ComponentMask mask, int count) {
+    Archetype& archetype = world.archetypes[findArchetype(world, mask)];
+    int chunks = (count + archetype.capacity - 1) / archetype.capacity;
+    while (static_cast<int>(archetype.chunks.size()) < chunks) {
+        archetype.chunks.emplace_back();
+        archetype.chunks.back().bytes.assign(ECS_CHUNK_BYTES, 0);
+    }
+}
+
+// El handle se entrega ya, pero la entidad no existe hasta el flush
+Entity createEntity(EntityWorld& world, const EntityInit& init) {
+    Entity entity = acquireHandle(world.handles);
+    if (entity == INVALID_HANDLE) {
+        return entity;
+    }
+    world.locations[entity & 0xFFFF] = {-1, 0, 0};
+    world.commands.push_back({entity, false, init});
+    return entity;
+}
+
+void destroyEntity(EntityWorld& world, Entity entity) {
+    if (denseIndex(world.handles, entity) >= 0) {
+        world.commands.push_back({entity, true, EntityInit()});
+    }
+}
+
+bool entityAlive(const EntityWorld& world, Entity entity) {
+    return denseIndex(world.handles, entity) >= 0 && world.locations[entity & 0xFFFF].archetype >= 0;
+}
+
+static void placeEntity(EntityWorld& world, Entity entity, const EntityInit& init) {
+    int a = findArchetype(world, init.mask);
+    Archetype& archetype = world.archetypes[a];
+    if (archetype.chunkCount == 0 || archetype.chunks[archetype.chunkCount - 1].count == archetype.capacity) {
+        if (archetype.chunkCount == static_cast<int>(archetype.chunks.size())) {
+            archetype.chunks.emplace_back();
+            archetype.chunks.back().bytes.assign(ECS_CHUNK_BYTES, 0);
+        }
+        archetype.chunks[archetype.chunkCount++].count = 0;
+    }
+
+    int c = archetype.chunkCount - 1;
+    EntityChunk& chunk = archetype.chunks[c];
+    int row = chunk.count++;
+    archetype.count++;
+    chunkEntities(chunk)[row] = entity;
+    world.locations[entity & 0xFFFF] = {a, c, row};
+
+    const void* values[COMPONENT_COUNT] = {&init.position, &init.velocity, &init.size, &init.color, &init.kind};
+    for (int i = 0; i < COMPONENT_COUNT; ++i) {
+        if (archetype.offsets[i] >= 0) {
+            std::memcpy(chunk.bytes.data() + archetype.offsets[i] + row * COMPONENT_SIZES[i], values[i], COMPONENT_SIZES[i]);
+        }
+    }
+}
+
+// Quita la entidad moviendo a su lugar la ultima del arquetipo, asi los
+// chunks siguen compactos
+static void removeEntity(EntityWorld& world, Entity entity) {
+    EntityLocation location = world.locations[entity & 0xFFFF];
+    world.locations[entity & 0xFFFF].archetype = -1;
+    removeDense(world.handles, denseIndex(world.handles, entity));
+    if (location.archetype < 0) {
+        return; // Se destruyo en el mismo tick en que se creo
+    }
+
+    Archetype& archetype = world.archetypes[location.archetype];
+    int lastChunk = archetype.chunkCount - 1;
+    EntityChunk& last = archetype.chunks[lastChunk];
+    EntityChunk& chunk = archetype.chunks[location.chunk];
+    int lastRow = last.count - 1;
+    if (location.chunk != lastChunk || location.row != lastRow) {
+        Entity moved = chunkEntities(last)[lastRow];
+        chunkEntities(chunk)[location.row] = moved;
+        for (int i = 0; i < COMPONENT_COUNT; ++i) {
+            if (archetype.offsets[i] >= 0) {
+                int size = COMPONENT_SIZES[i];
+                std::memcpy(chunk.bytes.data() + archetype.offsets[i] + location.row * size,
+                            last.bytes.data() + archetype.offsets[i] + lastRow * size, size);
+            }
+        }
+        world.locations[moved & 0xFFFF] = location;
+    }
+    last.count--;
+    archetype.count--;
+    if (last.count == 0) {
+        archetype.chunkCount--;
+    }
+}
+
+void flushEntityCommands(EntityWorld& world) {
+    PROFILE_ZONE("flushEntityCommands");
+    for (const EntityCommand& command : world.commands) {
+        if (denseIndex(world.handles, command.entity) < 0) {
+            continue; // Destruida dos veces en el mismo tick
+        }
+        if (command.destroy) {
+            removeEntity(world, command.entity);
+        } else {
+            placeEntity(world, command.entity, command.init);
+        }
+    }
+    world.commands.clear();
+}
+
+int entityCount(const EntityWorld& world, ComponentMask required) {
+    int count = 0;
+    for (const Archetype& archetype : world.archetypes) {
+        if ((archetype.mask & required) == required) {
+            count += archetype.count;
+        }
+    }
+    return count;
+}
+
+int entityChunkCount(const EntityWorld& world) {
+    int count = 0;
+    for (const Archetype& archetype : world.archetypes) {
+        count += archetype.chunkCount;
+    }
+    return count;
+}
+
+// Caja que cubre todas las entidades con posicion y tamano del mask
+SDL_Rect entityBounds(const EntityWorld& world, ComponentMask required) {
+    required |= componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_SIZE);
+    SDL_Rect bounds = {0, 0, 0, 0};
+    for (const Archetype& archetype : world.archetypes) {
+        if ((archetype.mask & required) != required) {
+            continue;
+        }
+        for (int c = 0; c < archetype.chunkCount; ++c) {
+            const EntityChunk& chunk = archetype.chunks[c];
+            const Position* position = reinterpret_cast<const Position*>(chunk.bytes.data() + archetype.offsets[COMPONENT_POSITION]);
+            const Size* size = reinterpret_cast<const Size*>(chunk.bytes.data() + archetype.offsets[COMPONENT_SIZE]);
+            for (int i = 0; i < chunk.count; ++i) {
+                SDL_Rect rect = entityRect(position[i], size[i]);
+                if (bounds.w == 0) {
+                    bounds = rect;
+                } else {
+                    SDL_UnionRect(&bounds, &rect, &bounds);
+                }
+            }
+        }
+    }
+    return bounds;
+}
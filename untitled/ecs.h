@@ -0,0 +1,141 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "handle_pool.h"
+
+// Entidades por arquetipo: todas las entidades con el mismo conjunto de
+// componentes comparten chunks de 16 KB, y dentro de cada chunk cada
+// componente es un arreglo contiguo. Los sistemas recorren esos arreglos.
+const int ECS_CHUNK_BYTES = 16 * 1024;
+const int MAX_ENTITIES = 4096; // Como mucho 65535: la ranura va en 16 bits del handle
+
+typedef Handle Entity;
+
+enum Component {
+    COMPONENT_POSITION, // Position
+    COMPONENT_VELOCITY, // Velocity
+    COMPONENT_SIZE,     // Size
+    COMPONENT_COLOR,    // SDL_Color
+    COMPONENT_KIND,     // Uint8, por ejemplo el tipo de power-up
+    // Etiquetas: solo marcan el arquetipo, no ocupan espacio
+    COMPONENT_BALL,
+    COMPONENT_PADDLE,
+    COMPONENT_POWERUP,
+    COMPONENT_LASER,
+    COMPONENT_COUNT
+};
+
+typedef Uint32 ComponentMask;
+
+inline ComponentMask componentBit(Component component) {
+    return 1u << component;
+}
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+struct Size {
+    int w, h;
+};
+
+// Valores de una entidad nueva; solo se copian los componentes del mask
+struct EntityInit {
+    ComponentMask mask = 0;
+    Position position = {0.0f, 0.0f};
+    Velocity velocity = {0.0f, 0.0f};
+    Size size = {0, 0};
+    SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF};
+    Uint8 kind = 0;
+};
+
+// Bloque de 16 KB: [Entity x capacity][columna de cada componente]
+struct EntityChunk {
+    std::vector<Uint8> bytes;
+    int count = 0;
+};
+
+struct Archetype {
+    ComponentMask mask = 0;
+    int capacity = 0;                     // Entidades por chunk
+    int offsets[COMPONENT_COUNT] = {};    // Columna de cada componente, -1 si no esta
+    std::vector<EntityChunk> chunks;      // Los vacios se guardan para reusarlos
+    int chunkCount = 0;                   // Chunks en uso; solo el ultimo puede estar incompleto
+    int count = 0;
+};
+
+struct EntityLocation {
+    int archetype; // -1 mientras la creacion esta pendiente
+    int chunk;
+    int row;
+};
+
+struct EntityCommand {
+    Entity entity;
+    bool destroy;
+    EntityInit init;
+};
+
+// Crear y destruir se difieren hasta flushEntityCommands, al final del
+// tick, para que los sistemas puedan recorrer chunks sin que se muevan.
+struct EntityWorld {
+    HandlePool handles;
+    std::vector<EntityLocation> locations; // Por ranura del handle
+    std::vector<Archetype> archetypes;
+    std::vector<EntityCommand> commands;
+};
+
+void initEntityWorld(EntityWorld& world, int capacity);
+void reserveEntities(EntityWorld& world, ComponentMask mask, int count);
+Entity createEntity(EntityWorld& world, const EntityInit& init);
+void destroyEntity(EntityWorld& world, Entity entity);
+void flushEntityCommands(EntityWorld& world);
+bool entityAlive(const EntityWorld& world, Entity entity);
+int entityCount(const EntityWorld& world, ComponentMask required);
+int entityChunkCount(const EntityWorld& world);
+SDL_Rect entityBounds(const EntityWorld& world, ComponentMask required);
+
+inline Entity* chunkEntities(EntityChunk& chunk) {
+    return reinterpret_cast<Entity*>(chunk.bytes.data());
+}
+
+template <typename T>
+T* chunkColumn(const Archetype& archetype, EntityChunk& chunk, Component component) {
+    return reinterpret_cast<T*>(chunk.bytes.data() + archetype.offsets[component]);
+}
+
+// Llama a visit(arquetipo, chunk) por cada chunk en uso cuyo arquetipo
+// tenga todos los componentes de `required`
+template <typename Visit>
+void forEachChunk(EntityWorld& world, ComponentMask required, Visit&& visit) {
+    for (Archetype& archetype : world.archetypes) {
+        if ((archetype.mask & required) != required) {
+            continue;
+        }
+        for (int c = 0; c < archetype.chunkCount; ++c) {
+            visit(archetype, archetype.chunks[c]);
+        }
+    }
+}
+
+// Componente de una entidad suelta, o nullptr si no existe o no lo tiene
+template <typename T>
+T* getComponent(EntityWorld& world, Entity entity, Component component) {
+    if (!entityAlive(world, entity)) {
+        return nullptr;
+    }
+    const EntityLocation& location = world.locations[entity & 0xFFFF];
+    Archetype& archetype = world.archetypes[location.archetype];
+    if (archetype.offsets[component] < 0) {
+        return nullptr;
+    }
+    return chunkColumn<T>(archetype, archetype.chunks[location.chunk], component) + location.row;
+}
+
+inline SDL_Rect entityRect(const Position& position, const Size& size) {
+    return {static_cast<int>(position.x), static_cast<int>(position.y), size.w, size.h};
+}
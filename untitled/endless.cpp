@@ -0,0 +1,176 @@
+#include "endless.h"
+#include "logger.h"
+#include "profiler.h"
+
+static Uint32 hashChunk(Uint32 seed, int id) {
+    Uint32 h = seed ^ (static_cast<Uint32>(id) * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h ? h : 1;
+}
+
+// Rellena un chunk a partir de la semilla; la densidad sube con la altura
+static void generateChunk(const EndlessWorld& world, Chunk& chunk, int id) {
+    PROFILE_ZONE("generateChunk");
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint32 state = hashChunk(world.seed, id);
+    Uint32 density = std::min(240, 150 + id * 4);
+
+    chunk.id = id;
+    chunk.top = world.chunkHeight * (-id);
+    chunk.alive = 0;
+    for (int r = 0; r < CHUNK_ROWS; ++r) {
+        // Algunas filas quedan como pasillo
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        bool corridor = (state & 0xFF) < 24;
+        for (int c = 0; c < world.columns; ++c) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            bool present = !corridor && (state >> 24) < density;
+            chunk.blocks[r * world.columns + c].destroyed = !present;
+            chunk.alive += present;
+        }
+    }
+    chunk.generationMs = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+}
+
+static void generatorLoop(EndlessWorld* world) {
+    registerLogThread("endless");
+    registerProfileThread("endless");
+    std::unique_lock<std::mutex> lock(world->mutex);
+    while (true) {
+        world->wake.wait(lock, [&] {
+            return world->quit || (!world->freeList.empty() && world->readyCount < ENDLESS_LOOKAHEAD);
+        });
+        if (world->quit) {
+            return;
+        }
+        Chunk* chunk = world->freeList.back();
+        world->freeList.pop_back();
+        int id = world->nextId++;
+        lock.unlock();
+        generateChunk(*world, *chunk, id);
+        logEvent(LOG_CHUNK_READY, id, 0, chunk->generationMs);
+        lock.lock();
+        int slot = (world->readyHead + world->readyCount) % static_cast<int>(world->ready.size());
+        world->ready[slot] = chunk;
+        world->readyCount++;
+    }
+}
+
+void initEndless(EndlessWorld& world, Uint32 seed, int columns, int blockWidth, int blockHeight, int worldHeight, int wallBottom) {
+    world.seed = seed;
+    world.columns = columns;
+    world.blockWidth = blockWidth;
+    world.blockHeight = blockHeight;
+    world.chunkHeight = CHUNK_ROWS * blockHeight;
+    world.worldHeight = worldHeight;
+    world.scroll = static_cast<float>(wallBottom - world.chunkHeight);
+
+    // Los chunks visibles, uno que entra, uno que sale y los adelantados
+    int poolSize = worldHeight / world.chunkHeight + 3 + ENDLESS_LOOKAHEAD;
+    world.pool.assign(poolSize, Chunk());
+    world.active.reserve(poolSize);
+    world.freeList.reserve(poolSize);
+    world.ready.assign(poolSize, nullptr);
+    for (auto& chunk : world.pool) {
+        chunk.blocks.resize(CHUNK_ROWS * columns);
+        for (int r = 0; r < CHUNK_ROWS; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                chunk.blocks[r * columns + c].rect = {c * blockWidth, r * blockHeight, blockWidth, blockHeight};
+            }
+        }
+        world.freeList.push_back(&chunk);
+    }
+
+    // La pared inicial se genera aqui mismo, hasta cubrir el borde superior
+    while (world.active.empty() || chunkWorldTop(world, *world.active.back()) > 0) {
+        Chunk* chunk = world.freeList.back();
+        world.freeList.pop_back();
+        generateChunk(world, *chunk, world.nextId++);
+        world.active.push_back(chunk);
+        world.generated++;
+    }
+
+    world.generator = std::thread(generatorLoop, &world);
+}
+
+void destroyEndless(EndlessWorld& world) {
+    {
+        std::lock_guard<std::mutex> lock(world.mutex);
+        world.quit = true;
+    }
+    world.wake.notify_all();
+    if (world.generator.joinable()) {
+        world.generator.join();
+    }
+}
+
+void updateEndless(EndlessWorld& world, float dT) {
+    PROFILE_ZONE("endless");
+    world.scroll += world.speed * dT;
+
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(world.mutex);
+
+        // Abajo: los chunks vacios o que ya salieron del mundo vuelven al pool
+        while (!world.active.empty()) {
+            Chunk* bottom = world.active.front();
+            if (bottom->alive > 0 && chunkWorldTop(world, *bottom) < world.worldHeight) {
+                break;
+            }
+            world.active.erase(world.active.begin());
+            world.freeList.push_back(bottom);
+            world.recycled++;
+            notify = true;
+        }
+
+        // Arriba: se engancha el siguiente chunk generado en cuanto hay hueco
+        while (world.active.empty() || chunkWorldTop(world, *world.active.back()) > 0) {
+            if (world.readyCount == 0) {
+                world.stalls++;
+                break;
+            }
+            Chunk* chunk = world.ready[world.readyHead];
+            world.readyHead = (world.readyHead + 1) % static_cast<int>(world.ready.size());
+            world.readyCount--;
+            world.active.push_back(chunk);
+            world.generated++;
+            world.generationMs += (chunk->generationMs - world.generationMs) * 0.1f;
+            world.maxGenerationMs = std::max(world.maxGenerationMs, chunk->generationMs);
+            notify = true;
+        }
+    }
+    if (notify) {
+        world.wake.notify_one();
+    }
+}
+
+int endlessAlive(const EndlessWorld& world) {
+    int alive = 0;
+    for (const Chunk* chunk : world.active) {
+        alive += chunk->alive;
+    }
+    return alive;
+}
+
+// Borde inferior del bloque vivo mas bajo, o -1 si no queda ninguno
+int endlessWallBottom(const EndlessWorld& world) {
+    for (const Chunk* chunk : world.active) {
+        for (int r = CHUNK_ROWS - 1; r >= 0 && chunk->alive > 0; --r) {
+            for (int c = 0; c < world.columns; ++c) {
+                if (!chunk->blocks[r * world.columns + c].destroyed) {
+                    return chunkWorldTop(world, *chunk) + (r + 1) * world.blockHeight;
+                }
+            }
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <SDL.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "blocks.h"
+
+const int CHUNK_ROWS = 8;
+const int ENDLESS_LOOKAHEAD = 4;
+const float ENDLESS_SCROLL_SPEED = 6.0f; // Pixeles por segundo
+
+// Franja de CHUNK_ROWS filas de bloques. Las posiciones son relativas a la
+// pared y se fijan al crear el pool; generar un chunk solo decide que
+// bloques existen, asi que reciclarlo no reserva memoria.
+struct Chunk {
+    int id = 0;   // Orden desde el inicio de la pared, tambien define su semilla
+    int top = 0;  // Borde superior en coordenadas de la pared
+    int alive = 0;
+    float generationMs = 0.0f;
+    std::vector<Block> blocks; // CHUNK_ROWS x columns, por filas
+};
+
+// Pared que baja sin fin. Los chunks nuevos se generan por adelantado en
+// un hilo de fondo; los que salen por abajo vuelven a la lista libre.
+struct EndlessWorld {
+    Uint32 seed = 1;
+    int columns = 0;
+    int blockWidth = 0;
+    int blockHeight = 0;
+    int chunkHeight = 0;
+    int worldHeight = 0;
+    float scroll = 0.0f; // Desplazamiento de la pared hacia abajo
+    float speed = ENDLESS_SCROLL_SPEED;
+
+    std::vector<Chunk> pool;
+    std::vector<Chunk*> active; // De abajo hacia arriba
+
+    // Compartido con el hilo generador, protegido por `mutex`
+    std::vector<Chunk*> freeList;
+    std::vector<Chunk*> ready; // Cola circular de chunks ya generados
+    int readyHead = 0;
+    int readyCount = 0;
+    int nextId = 0;
+    bool quit = false;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread generator;
+
+    // Estadisticas
+    int generated = 0;
+    int recycled = 0;
+    int stalls = 0;
+    float generationMs = 0.0f;
+    float maxGenerationMs = 0.0f;
+};
+
+void initEndless(EndlessWorld& world, Uint32 seed, int columns, int blockWidth, int blockHeight, int worldHeight, int wallBottom);
+void destroyEndless(EndlessWorld& world);
+void updateEndless(EndlessWorld& world, float dT);
+int endlessAlive(const EndlessWorld& world);
+int endlessWallBottom(const EndlessWorld& world);
+
+inline int chunkWorldTop(const EndlessWorld& world, const Chunk& chunk) {
+    return chunk.top + static_cast<int>(world.scroll);
+}
+
+// Llama a visit(bloque, rectangulo en el mundo) por cada bloque vivo que
+// toca `area`. Las filas y columnas salen directo de la posicion, sin buscar.
+// Si visit devuelve true la consulta se detiene.
+template <typename Visit>
+void queryEndless(EndlessWorld& world, const SDL_Rect& area, Visit&& visit) {
+    for (Chunk* chunk : world.active) {
+        int top = chunkWorldTop(world, *chunk);
+        if (area.y >= top + world.chunkHeight || area.y + area.h <= top) {
+            continue;
+        }
+        int r0 = std::max(0, (area.y - top) / world.blockHeight);
+        int r1 = std::min(CHUNK_ROWS - 1, (area.y + area.h - 1 - top) / world.blockHeight);
+        int c0 = std::max(0, area.x / world.blockWidth);
+        int c1 = std::min(world.columns - 1, (area.x + area.w - 1) / world.blockWidth);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                Block& block = chunk->blocks[r * world.columns + c];
+                if (block.destroyed) {
+                    continue;
+                }
+                SDL_Rect rect = block.rect;
+                rect.y += top;
+                if (visit(*chunk, block, rect)) {
+                    return;
+                }
+            }
+        }
+    }
+}
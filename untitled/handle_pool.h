@@ -0,0 +1,78 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// Handle generacional: generacion << 16 | ranura. Al reciclar una ranura
+// su generacion cambia, asi un handle viejo deja de ser valido.
+typedef Uint32 Handle;
+const Handle INVALID_HANDLE = 0;
+
+// Pool de capacidad fija que no reserva memoria despues de init. Los vivos
+// quedan compactos en dense[0, count), en el mismo orden que los datos del
+// llamador, para recorrerlos sin huecos.
+struct HandlePool {
+    std::vector<Uint16> generation; // Por ranura, nunca 0
+    std::vector<int> dense;         // Ranura de cada posicion viva
+    std::vector<int> denseOf;       // Posicion de cada ranura, -1 si esta libre
+    std::vector<int> freeSlots;
+    int count = 0;
+    int capacity = 0;
+    int dropped = 0;
+};
+
+inline void initHandlePool(HandlePool& pool, int capacity) {
+    pool.capacity = capacity;
+    pool.count = 0;
+    pool.dropped = 0;
+    pool.generation.assign(capacity, 1);
+    pool.dense.assign(capacity, 0);
+    pool.denseOf.assign(capacity, -1);
+    pool.freeSlots.clear();
+    pool.freeSlots.reserve(capacity);
+    for (int slot = capacity - 1; slot >= 0; --slot) {
+        pool.freeSlots.push_back(slot);
+    }
+}
+
+// Devuelve el handle nuevo; sus datos van en la posicion count - 1
+inline Handle acquireHandle(HandlePool& pool) {
+    if (pool.freeSlots.empty()) {
+        pool.dropped++;
+        return INVALID_HANDLE;
+    }
+    int slot = pool.freeSlots.back();
+    pool.freeSlots.pop_back();
+    pool.dense[pool.count] = slot;
+    pool.denseOf[slot] = pool.count;
+    pool.count++;
+    return (static_cast<Handle>(pool.generation[slot]) << 16) | static_cast<Handle>(slot);
+}
+
+inline Handle handleAt(const HandlePool& pool, int pos) {
+    int slot = pool.dense[pos];
+    return (static_cast<Handle>(pool.generation[slot]) << 16) | static_cast<Handle>(slot);
+}
+
+// Posicion densa del handle, o -1 si ya no es valido
+inline int denseIndex(const HandlePool& pool, Handle handle) {
+    int slot = static_cast<int>(handle & 0xFFFF);
+    if (handle == INVALID_HANDLE || slot >= pool.capacity || pool.generation[slot] != (handle >> 16)) {
+        return -1;
+    }
+    return pool.denseOf[slot];
+}
+
+// Libera la posicion `pos`: la ultima pasa a ocuparla. El llamador mueve
+// sus datos igual antes (data[pos] = data[count - 1]).
+inline void removeDense(HandlePool& pool, int pos) {
+    int slot = pool.dense[pos];
+    int last = pool.count - 1;
+    pool.dense[pos] = pool.dense[last];
+    pool.denseOf[pool.dense[pos]] = pos;
+    pool.count = last;
+    pool.denseOf[slot] = -1;
+    if (++pool.generation[slot] == 0) {
+        pool.generation[slot] = 1;
+    }
+    pool.freeSlots.push_back(slot);
+}
@@ -0,0 +1,296 @@
+#include "level.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+// Comprueba que una tabla cae dentro del archivo y esta alineada
+static bool sectionFits(size_t fileSize, Uint32 offset, Uint64 bytes) {
+    return offset % 4 == 0 && static_cast<Uint64>(offset) + bytes <= fileSize;
+}
+
+// Una pasada por la rejilla del archivo: queryBlockGrid usa estos indices
+// sin comprobar nada, asi que un archivo corrupto no puede llegar ahi
+static bool gridIndicesValid(const int* cellStart, const int* items, Uint64 cells, int count) {
+    if (cellStart[0] != 0 || cellStart[cells] != count) {
+        return false;
+    }
+    for (Uint64 c = 0; c < cells; ++c) {
+        if (cellStart[c + 1] < cellStart[c]) {
+            return false;
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        if (items[i] < 0 || items[i] >= count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Celdas que armaria buildBlockGrid para ese mundo, en 64 bits para que
+// una cabecera corrupta no desborde
+static Uint64 worldGridCells(Uint32 worldWidth, Uint32 worldHeight) {
+    Uint64 columns = (static_cast<Uint64>(worldWidth) + GRID_CELL_WIDTH - 1) / GRID_CELL_WIDTH;
+    Uint64 rows = (static_cast<Uint64>(worldHeight) + GRID_CELL_HEIGHT - 1) / GRID_CELL_HEIGHT;
+    return columns * rows;
+}
+
+// Valida la cabecera y apunta las tablas a `data`, que puede ser el archivo
+// mapeado, una entrada del paquete de assets o una copia descomprimida
+static bool useLevelData(Level& level, unsigned char* data, size_t size, const char* name) {
+    const LevelHeader* header = reinterpret_cast<const LevelHeader*>(data);
+    bool valid = size >= sizeof(LevelHeader) &&
+                 header->magic == LEVEL_MAGIC &&
+                 header->version == LEVEL_VERSION &&
+                 header->headerSize == sizeof(LevelHeader) &&
+                 header->blockCount <= 0x7FFFFFFF / sizeof(Block) &&
+                 header->breakableCount <= header->blockCount &&
+                 header->paletteCount <= MAX_PALETTE_COLORS &&
+                 sectionFits(size, header->paletteOffset, header->paletteCount * sizeof(SDL_Color)) &&
+                 sectionFits(size, header->blockOffset, static_cast<Uint64>(header->blockCount) * sizeof(Block)) &&
+                 sectionFits(size, header->attributesOffset, static_cast<Uint64>(header->blockCount) * sizeof(BlockAttributes)) &&
+                 header->worldWidth > 0 && header->worldWidth <= 0x7FFFFFFF - GRID_CELL_WIDTH &&
+                 header->worldHeight > 0 && header->worldHeight <= 0x7FFFFFFF - GRID_CELL_HEIGHT &&
+                 worldGridCells(header->worldWidth, header->worldHeight) < 0x10000000;
+    if (!valid) {
+        std::cerr << "Invalid or unsupported level file " << name << std::endl;
+        return false;
+    }
+
+    level.blocks = reinterpret_cast<Block*>(data + header->blockOffset);
+    level.attributes = reinterpret_cast<BlockAttributes*>(data + header->attributesOffset);
+    level.count = static_cast<int>(header->blockCount);
+    level.breakable = static_cast<int>(header->breakableCount);
+    level.paletteCount = static_cast<int>(header->paletteCount);
+    std::memcpy(level.palette, data + header->paletteOffset, header->paletteCount * sizeof(SDL_Color));
+    level.worldWidth = static_cast<int>(header->worldWidth);
+    level.worldHeight = static_cast<int>(header->worldHeight);
+
+    // La rejilla del archivo solo sirve si se hizo con las mismas celdas
+    Uint64 cells = static_cast<Uint64>(header->gridColumns) * header->gridRows;
+    level.gridFromFile = header->gridColumns > 0 &&
+                         header->gridCellWidth == GRID_CELL_WIDTH &&
+                         header->gridCellHeight == GRID_CELL_HEIGHT &&
+                         cells < 0x10000000 &&
+                         header->gridMaxBlockWidth <= 0x7FFFFFFF &&
+                         header->gridMaxBlockHeight <= 0x7FFFFFFF &&
+                         sectionFits(size, header->cellStartOffset, (cells + 1) * sizeof(int)) &&
+                         sectionFits(size, header->itemsOffset, static_cast<Uint64>(header->blockCount) * sizeof(int));
+    if (level.gridFromFile) {
+        const int* cellStart = reinterpret_cast<const int*>(data + header->cellStartOffset);
+        const int* items = reinterpret_cast<const int*>(data + header->itemsOffset);
+        // Si no cierra se rearma en memoria, igual que sin rejilla
+        level.gridFromFile = gridIndicesValid(cellStart, items, cells, level.count);
+        if (!level.gridFromFile) {
+            std::cerr << "Invalid grid in level file " << name << ", rebuilding it" << std::endl;
+        }
+        level.grid.columns = static_cast<int>(header->gridColumns);
+        level.grid.rows = static_cast<int>(header->gridRows);
+        level.grid.maxBlockWidth = static_cast<int>(header->gridMaxBlockWidth);
+        level.grid.maxBlockHeight = static_cast<int>(header->gridMaxBlockHeight);
+        level.grid.cellStart = cellStart;
+        level.grid.items = items;
+    }
+    if (!level.gridFromFile) {
+        buildBlockGrid(level.grid, level.blocks, level.count, level.worldWidth, level.worldHeight);
+    }
+    level.broken.reserve(level.count);
+    level.chain.reserve(level.count);
+    return true;
+}
+
+bool loadLevel(Level& level, const char* path) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN) {
+        std::cerr << "Level files are little-endian; this platform is not supported" << std::endl;
+        return false;
+    }
+    if (!mapFile(level.file, path, true)) {
+        std::cerr << "Error opening level " << path << std::endl;
+        return false;
+    }
+    // Se validan la cabecera y los indices de la rejilla; las tablas se usan
+    // tal cual desde el mapeo
+    if (!useLevelData(level, level.file.data, level.file.size, path)) {
+        unmapFile(level.file);
+        return false;
+    }
+    level.loadMs = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+    return true;
+}
+
+bool loadLevel(Level& level, const AssetPack& pack, const char* name) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    const PackEntry* entry = findAsset(pack, name);
+    if (!entry) {
+        std::cerr << "Level " << name << " is not in " << pack.path << std::endl;
+        return false;
+    }
+    unsigned char* data = nullptr;
+    if (entry->flags & PACK_ENTRY_COMPRESSED) {
+        level.packedCopy.resize(entry->size);
+        if (readAsset(pack, *entry, 0, entry->size, level.packedCopy.data())) {
+            data = level.packedCopy.data();
+        }
+    } else if (mapFile(level.file, pack.path.c_str(), true) && level.file.size == pack.file.size) {
+        // Sin comprimir se usa en el lugar, pero con un mapeo propio con copia
+        // en escritura: romper bloques no toca el mapeo compartido del paquete
+        data = level.file.data + entry->offset;
+    }
+    if (!data || !useLevelData(level, data, entry->size, name)) {
+        if (!data) {
+            std::cerr << "Error reading level " << name << " from " << pack.path << std::endl;
+        }
+        unmapFile(level.file);
+        level.packedCopy.clear();
+        return false;
+    }
+    level.loadMs = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+    return true;
+}
+
+// Nivel generado en codigo: las tablas ya estan en blockStorage/attributeStorage
+// y la paleta ya esta asignada
+void useLevelStorage(Level& level, int worldWidth, int worldHeight) {
+    level.blocks = level.blockStorage.data();
+    level.attributes = level.attributeStorage.data();
+    level.count = static_cast<int>(level.blockStorage.size());
+    level.breakable = 0;
+    for (int i = 0; i < level.count; ++i) {
+        level.breakable += blockType(level.attributes[i]) != BLOCK_UNBREAKABLE;
+    }
+    level.worldWidth = worldWidth;
+    level.worldHeight = worldHeight;
+    level.gridFromFile = false;
+    buildBlockGrid(level.grid, level.blocks, level.count, worldWidth, worldHeight);
+    level.broken.reserve(level.count);
+    level.chain.reserve(level.count);
+}
+
+void unloadLevel(Level& level) {
+    unmapFile(level.file);
+    level.packedCopy.clear();
+    level.blockStorage.clear();
+    level.attributeStorage.clear();
+    level.blocks = nullptr;
+    level.attributes = nullptr;
+    level.count = 0;
+    level.breakable = 0;
+    level.paletteCount = 0;
+    level.grid = BlockGrid();
+}
+
+static Uint32 alignUp(Uint64 offset) {
+    return static_cast<Uint32>((offset + 3) & ~static_cast<Uint64>(3));
+}
+
+// Rellena con ceros hasta `offset` y escribe la tabla
+static bool writeSection(std::FILE* file, Uint64& written, Uint32 offset, const void* data, size_t bytes) {
+    for (; written < offset; ++written) {
+        if (std::fputc(0, file) == EOF) {
+            return false;
+        }
+    }
+    written += bytes;
+    return bytes == 0 || std::fwrite(data, 1, bytes, file) == bytes;
+}
+
+bool writeLevel(const char* path, const Block* blocks, const BlockAttributes* attributes, int count,
+                const SDL_Color* palette, int paletteCount, int worldWidth, int worldHeight) {
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN) {
+        std::cerr << "Level files are little-endian; this platform is not supported" << std::endl;
+        return false;
+    }
+
+    BlockGrid grid;
+    buildBlockGrid(grid, blocks, count, worldWidth, worldHeight);
+    int cells = grid.columns * grid.rows;
+
+    LevelHeader header = {};
+    header.magic = LEVEL_MAGIC;
+    header.version = LEVEL_VERSION;
+    header.headerSize = sizeof(LevelHeader);
+    header.blockCount = static_cast<Uint32>(count);
+    for (int i = 0; i < count; ++i) {
+        header.breakableCount += blockType(attributes[i]) != BLOCK_UNBREAKABLE;
+    }
+    header.worldWidth = static_cast<Uint32>(worldWidth);
+    header.worldHeight = static_cast<Uint32>(worldHeight);
+    header.paletteCount = static_cast<Uint32>(paletteCount);
+    header.paletteOffset = sizeof(LevelHeader);
+    header.blockOffset = alignUp(header.paletteOffset + paletteCount * sizeof(SDL_Color));
+    header.attributesOffset = alignUp(header.blockOffset + static_cast<Uint64>(count) * sizeof(Block));
+    header.gridColumns = static_cast<Uint32>(grid.columns);
+    header.gridRows = static_cast<Uint32>(grid.rows);
+    header.gridCellWidth = GRID_CELL_WIDTH;
+    header.gridCellHeight = GRID_CELL_HEIGHT;
+    header.gridMaxBlockWidth = static_cast<Uint32>(grid.maxBlockWidth);
+    header.gridMaxBlockHeight = static_cast<Uint32>(grid.maxBlockHeight);
+    header.cellStartOffset = alignUp(header.attributesOffset + static_cast<Uint64>(count) * sizeof(BlockAttributes));
+    header.itemsOffset = alignUp(header.cellStartOffset + static_cast<Uint64>(cells + 1) * sizeof(int));
+
+    // Los bloques siempre se guardan sin destruir
+    std::vector<Block> fresh(blocks, blocks + count);
+    for (auto& block : fresh) {
+        block.destroyed = false;
+    }
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cerr << "Error creating " << path << std::endl;
+        return false;
+    }
+    Uint64 written = 0;
+    bool ok = writeSection(file, written, 0, &header, sizeof(header)) &&
+              writeSection(file, written, header.paletteOffset, palette, paletteCount * sizeof(SDL_Color)) &&
+              writeSection(file, written, header.blockOffset, fresh.data(), count * sizeof(Block)) &&
+              writeSection(file, written, header.attributesOffset, attributes, count * sizeof(BlockAttributes)) &&
+              writeSection(file, written, header.cellStartOffset, grid.cellStart, (cells + 1) * sizeof(int)) &&
+              writeSection(file, written, header.itemsOffset, grid.items, count * sizeof(int));
+    if (std::fclose(file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        std::cerr << "Error writing " << path << std::endl;
+    }
+    return ok;
+}
+
+// Rompe el bloque y resuelve las explosiones en cadena con un flood-fill
+// iterativo: cada bloque se marca al entrar en la pila, asi se visita una
+// sola vez. Los indices rotos quedan en level.broken.
+int breakBlock(Level& level, int index) {
+    level.broken.clear();
+    level.chain.clear();
+    Block& first = level.blocks[index];
+    if (first.destroyed || blockType(level.attributes[index]) == BLOCK_UNBREAKABLE) {
+        return 0;
+    }
+    first.destroyed = true;
+    level.broken.push_back(index);
+    if (blockType(level.attributes[index]) == BLOCK_EXPLOSIVE) {
+        level.chain.push_back(index);
+    }
+
+    while (!level.chain.empty()) {
+        const SDL_Rect& r = level.blocks[level.chain.back()].rect;
+        level.chain.pop_back();
+        // La explosion alcanza a los vecinos que tocan el bloque (8 direcciones)
+        SDL_Rect blast = {r.x - r.w + 1, r.y - r.h + 1, 3 * r.w - 2, 3 * r.h - 2};
+        queryBlockGrid(level.grid, blast, [&](int i) {
+            Block& block = level.blocks[i];
+            BlockType type = blockType(level.attributes[i]);
+            if (block.destroyed || type == BLOCK_UNBREAKABLE || !SDL_HasIntersection(&block.rect, &blast)) {
+                return false;
+            }
+            block.destroyed = true;
+            level.broken.push_back(i);
+            if (type == BLOCK_EXPLOSIVE) {
+                level.chain.push_back(i);
+            }
+            return false;
+        });
+    }
+    level.breakable -= static_cast<int>(level.broken.size());
+    return static_cast<int>(level.broken.size());
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "asset_pack.h"
+#include "blocks.h"
+#include "mapped_file.h"
+
+const Uint32 LEVEL_MAGIC = 0x4C4B5242; // "BRKL" leido en little-endian
+const Uint32 LEVEL_VERSION = 2;
+
+// Cabecera del archivo de nivel. Todo es little-endian y con alineacion
+// de 4 bytes, para usar las tablas directamente desde el mapeo.
+//   [cabecera][paleta][Block x blockCount][BlockAttributes x blockCount][rejilla opcional]
+struct LevelHeader {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 headerSize;
+    Uint32 blockCount;
+    Uint32 breakableCount;
+    Uint32 worldWidth;
+    Uint32 worldHeight;
+    Uint32 paletteCount;
+    Uint32 paletteOffset; // SDL_Color x paletteCount
+    Uint32 blockOffset;
+    Uint32 attributesOffset;
+    // Rejilla espacial precalculada (gridColumns == 0 si no hay)
+    Uint32 gridColumns;
+    Uint32 gridRows;
+    Uint32 gridCellWidth;
+    Uint32 gridCellHeight;
+    Uint32 gridMaxBlockWidth;
+    Uint32 gridMaxBlockHeight;
+    Uint32 cellStartOffset;
+    Uint32 itemsOffset;
+    Uint32 reserved;
+};
+static_assert(sizeof(LevelHeader) == 80, "LevelHeader layout is part of the file format");
+
+// Nivel activo: sus tablas apuntan al archivo mapeado (suelto o dentro del
+// paquete de assets), a la copia descomprimida del paquete o a los vectores
+// propios cuando el nivel se genera en codigo.
+struct Level {
+    MappedFile file;
+    std::vector<unsigned char> packedCopy;
+    std::vector<Block> blockStorage;
+    std::vector<BlockAttributes> attributeStorage;
+    Block* blocks = nullptr;
+    BlockAttributes* attributes = nullptr;
+    int count = 0;
+    int breakable = 0; // Bloques que hay que romper para ganar
+    SDL_Color palette[MAX_PALETTE_COLORS] = {};
+    int paletteCount = 0;
+    int worldWidth = 0;
+    int worldHeight = 0;
+    BlockGrid grid;
+    bool gridFromFile = false;
+    float loadMs = 0.0f;
+
+    // Resultado del ultimo breakBlock y pila de la reaccion en cadena,
+    // reservados al cargar para no reservar durante el juego
+    std::vector<int> broken;
+    std::vector<int> chain;
+};
+
+bool loadLevel(Level& level, const char* path);
+bool loadLevel(Level& level, const AssetPack& pack, const char* name);
+void useLevelStorage(Level& level, int worldWidth, int worldHeight);
+void unloadLevel(Level& level);
+bool writeLevel(const char* path, const Block* blocks, const BlockAttributes* attributes, int count,
+                const SDL_Color* palette, int paletteCount, int worldWidth, int worldHeight);
+int breakBlock(Level& level, int index);
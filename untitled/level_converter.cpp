@@ -0,0 +1,183 @@
+// Convierte niveles de texto al formato binario que carga el juego.
+//
+//   level_converter nivel.txt nivel.lvl
+//   level_converter --fill COLUMNAS FILAS nivel.lvl   (nivel grande de prueba)
+//
+// Formato de texto:
+//   # comentario
+//   block 64 20              tamano de cada bloque
+//   world 640 480            tamano del mundo (opcional)
+//   legend G 00FF00 1 normal caracter, color RGB, puntos de vida y tipo
+//                            (normal, unbreakable o explosive)
+//   layout                   a partir de aqui, una fila de bloques por linea;
+//   GGGGGGGGGG               '.' o ' ' dejan el hueco vacio
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "level.h"
+
+struct Legend {
+    BlockAttributes attributes = 0;
+    bool used = false;
+};
+
+// Indice del color en la paleta, agregandolo si es nuevo
+static int paletteIndex(std::vector<SDL_Color>& palette, SDL_Color color) {
+    for (int i = 0; i < static_cast<int>(palette.size()); ++i) {
+        if (palette[i].r == color.r && palette[i].g == color.g && palette[i].b == color.b) {
+            return i;
+        }
+    }
+    if (static_cast<int>(palette.size()) == MAX_PALETTE_COLORS) {
+        return -1;
+    }
+    palette.push_back(color);
+    return static_cast<int>(palette.size()) - 1;
+}
+
+static bool convertText(const char* input, const char* output) {
+    std::ifstream in(input);
+    if (!in) {
+        std::cerr << "Error opening " << input << std::endl;
+        return false;
+    }
+
+    Legend legend[128];
+    int blockWidth = 64, blockHeight = 20;
+    int worldWidth = 0, worldHeight = 0;
+    bool inLayout = false;
+    int row = 0;
+    std::vector<Block> blocks;
+    std::vector<BlockAttributes> attributes;
+    std::vector<SDL_Color> palette;
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (inLayout) {
+            for (int col = 0; col < static_cast<int>(line.size()); ++col) {
+                unsigned char c = static_cast<unsigned char>(line[col]);
+                if (c == '.' || c == ' ') {
+                    continue;
+                }
+                if (c >= 128 || !legend[c].used) {
+                    std::cerr << input << ":" << lineNumber << ": unknown block '" << line[col] << "'" << std::endl;
+                    return false;
+                }
+                blocks.push_back({{col * blockWidth, row * blockHeight, blockWidth, blockHeight}});
+                attributes.push_back(legend[c].attributes);
+            }
+            row++;
+            continue;
+        }
+
+        std::istringstream words(line);
+        std::string keyword;
+        if (!(words >> keyword) || keyword[0] == '#') {
+            continue;
+        }
+        if (keyword == "block") {
+            words >> blockWidth >> blockHeight;
+        } else if (keyword == "world") {
+            words >> worldWidth >> worldHeight;
+        } else if (keyword == "legend") {
+            std::string symbol, color, typeName = "normal";
+            int hitPoints = 1;
+            words >> symbol >> color >> hitPoints;
+            if (!(words >> typeName)) {
+                words.clear(); // El tipo es opcional
+            }
+            unsigned long rgb = std::strtoul(color.c_str(), nullptr, 16);
+            unsigned char c = symbol.empty() ? 0 : static_cast<unsigned char>(symbol[0]);
+            int index = paletteIndex(palette, {static_cast<Uint8>(rgb >> 16), static_cast<Uint8>(rgb >> 8), static_cast<Uint8>(rgb), 0xFF});
+            BlockType type = typeName == "unbreakable" ? BLOCK_UNBREAKABLE : typeName == "explosive" ? BLOCK_EXPLOSIVE : BLOCK_NORMAL;
+            if (c == 0 || c >= 128 || hitPoints < 1 || hitPoints > MAX_BLOCK_HIT_POINTS || index < 0 ||
+                (type == BLOCK_NORMAL && typeName != "normal")) {
+                std::cerr << input << ":" << lineNumber << ": bad legend" << std::endl;
+                return false;
+            }
+            legend[c].attributes = packBlockAttributes(hitPoints, type, index);
+            legend[c].used = true;
+        } else if (keyword == "layout") {
+            inLayout = true;
+        } else {
+            std::cerr << input << ":" << lineNumber << ": unknown keyword " << keyword << std::endl;
+            return false;
+        }
+        if (!words && !words.eof()) {
+            std::cerr << input << ":" << lineNumber << ": bad value" << std::endl;
+            return false;
+        }
+    }
+
+    // Sin tamano de mundo explicito, el ancho de la capa y el alto de pantalla
+    if (worldWidth == 0) {
+        int columns = 0;
+        for (const auto& block : blocks) {
+            columns = std::max(columns, block.rect.x / blockWidth + 1);
+        }
+        worldWidth = std::max(640, columns * blockWidth);
+        worldHeight = worldWidth * 3 / 4;
+    }
+    return writeLevel(output, blocks.data(), attributes.data(), static_cast<int>(blocks.size()),
+                      palette.data(), static_cast<int>(palette.size()), worldWidth, worldHeight);
+}
+
+// Nivel sintetico para medir la carga con muchos bloques
+static bool fillLevel(int columns, int rows, const char* output) {
+    const int blockWidth = 64, blockHeight = 20;
+    const SDL_Color palette[] = {{0x00, 0xFF, 0x00, 0xFF}, {0x20, 0xA0, 0xFF, 0xFF}, {0xFF, 0xD0, 0x40, 0xFF},
+                                 {0x80, 0x80, 0x80, 0xFF}, {0xFF, 0x40, 0x20, 0xFF}};
+    std::vector<Block> blocks;
+    std::vector<BlockAttributes> attributes;
+    blocks.reserve(static_cast<size_t>(columns) * rows);
+    attributes.reserve(static_cast<size_t>(columns) * rows);
+    Uint32 seed = 0x9E3779B9u;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            int band = (r / 4 + c / 8) % 3;
+            // Algunos bloques grises irrompibles y rojos explosivos
+            BlockAttributes a = packBlockAttributes(band + 1, BLOCK_NORMAL, band);
+            if (seed % 100 < 2) {
+                a = packBlockAttributes(1, BLOCK_UNBREAKABLE, 3);
+            } else if (seed % 100 < 12) {
+                a = packBlockAttributes(1, BLOCK_EXPLOSIVE, 4);
+            }
+            blocks.push_back({{c * blockWidth, r * blockHeight, blockWidth, blockHeight}});
+            attributes.push_back(a);
+        }
+    }
+    // Misma proporcion que el nivel normal: 5 filas en 480 px
+    int worldWidth = columns * blockWidth;
+    int worldHeight = rows * blockHeight * 480 / 100;
+    return writeLevel(output, blocks.data(), attributes.data(), static_cast<int>(blocks.size()), palette, 5, worldWidth, worldHeight);
+}
+
+int main(int argc, char* argv[]) {
+    bool ok;
+    if (argc == 5 && std::strcmp(argv[1], "--fill") == 0) {
+        ok = fillLevel(std::atoi(argv[2]), std::atoi(argv[3]), argv[4]);
+    } else if (argc == 3) {
+        ok = convertText(argv[1], argv[2]);
+    } else {
+        std::cerr << "usage: level_converter input.txt output.lvl" << std::endl;
+        std::cerr << "       level_converter --fill COLUMNS ROWS output.lvl" << std::endl;
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+thread_local LogRing* logRing = nullptr;
+std::atomic<Uint32> logFrame{0};
+std::atomic<Uint32> logUnregisteredDrops{0};
+
+// Anillos fijos: registrar un hilo no reserva memoria
+static LogRing rings[MAX_LOG_THREADS];
+static std::atomic<int> ringCount{0};
+
+static std::thread writer;
+static std::atomic<bool> writerQuit{false};
+static std::atomic<long long> written{0};
+static FILE* output = nullptr;
+static bool ownsOutput = false;
+
+void registerLogThread(const char* name) {
+    if (logRing) {
+        return;
+    }
+    int index = ringCount.fetch_add(1);
+    if (index >= MAX_LOG_THREADS) {
+        ringCount.fetch_sub(1);
+        return;
+    }
+    rings[index].thread = index;
+    rings[index].name = name;
+    logRing = &rings[index];
+}
+
+static int formatRecord(const LogRing& ring, const LogRecord& r, char* buffer, int size) {
+    int n = std::snprintf(buffer, size, "[frame %u] [%s #%u] ", r.frame, ring.name, r.sequence);
+    buffer += n;
+    size -= n;
+    switch (r.type) {
+    case LOG_GAME_OVER:
+        return n + std::snprintf(buffer, size, "Game Over (score %d)\n", r.a);
+    case LOG_YOU_WIN:
+        return n + std::snprintf(buffer, size, "You Win! (score %d)\n", r.a);
+    case LOG_LIFE_LOST:
+        return n + std::snprintf(buffer, size, "Life lost, %d left\n", r.a);
+    case LOG_BLOCK_BROKEN:
+        return n + std::snprintf(buffer, size, "Block broken at %d,%d\n", r.a, r.b);
+    case LOG_PADDLE_BOUNCE:
+        return n + std::snprintf(buffer, size, "Paddle bounce at x %d, speed %.1f\n", r.a, r.value);
+    case LOG_POWERUP:
+        return n + std::snprintf(buffer, size, "Power-up %d collected\n", r.a);
+    case LOG_CHUNK_READY:
+        return n + std::snprintf(buffer, size, "Chunk %d generated in %.3f ms\n", r.a, r.value);
+    case LOG_ASSET_READY:
+        return n + std::snprintf(buffer, size, "Asset %d %s after %.3f ms\n", r.a, r.b ? "failed" : "ready", r.value);
+    case LOG_LEVEL_SWITCH:
+        return n + std::snprintf(buffer, size, "Level %d started, switch took %.3f ms\n", r.a, r.value);
+    default:
+        return n + std::snprintf(buffer, size, "Event %u (%d, %d, %f)\n", r.type, r.a, r.b, r.value);
+    }
+}
+
+// Vacia todos los anillos; devuelve cuantos registros escribio
+static int drainRings() {
+    char line[160];
+    int drained = 0;
+    int count = std::min(ringCount.load(std::memory_order_acquire), MAX_LOG_THREADS);
+    for (int i = 0; i < count; ++i) {
+        LogRing& ring = rings[i];
+        Uint32 tail = ring.tail.load(std::memory_order_relaxed);
+        Uint32 head = ring.head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            int length = formatRecord(ring, ring.records[tail & (LOG_RING_SIZE - 1)], line, sizeof(line));
+            if (output) {
+                std::fwrite(line, 1, std::min(length, static_cast<int>(sizeof(line)) - 1), output);
+            }
+            drained++;
+        }
+        ring.tail.store(tail, std::memory_order_release);
+    }
+    if (output && drained > 0) {
+        std::fflush(output);
+    }
+    written.fetch_add(drained, std::memory_order_relaxed);
+    return drained;
+}
+
+// El productor nunca avisa (seria una llamada al sistema en el tick);
+// el escritor revisa los anillos cada pocos milisegundos
+static void writerLoop() {
+    while (!writerQuit.load(std::memory_order_acquire)) {
+        if (drainRings() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    drainRings();
+}
+
+bool startLogger(const char* path) {
+    output = stdout;
+    ownsOutput = false;
+    if (path) {
+        output = std::fopen(path, "w");
+        if (!output) {
+            std::fprintf(stderr, "Error opening log %s\n", path);
+            return false;
+        }
+        ownsOutput = true;
+    }
+    writerQuit = false;
+    writer = std::thread(writerLoop);
+    return true;
+}
+
+void stopLogger() {
+    if (!writer.joinable()) {
+        return;
+    }
+    writerQuit.store(true, std::memory_order_release);
+    writer.join();
+    long long dropped = loggerDropped();
+    if (output && dropped > 0) {
+        std::fprintf(output, "%lld log records dropped\n", dropped);
+    }
+    if (ownsOutput) {
+        std::fclose(output);
+    }
+    output = nullptr;
+}
+
+long long loggerWritten() {
+    return written.load(std::memory_order_relaxed);
+}
+
+long long loggerDropped() {
+    long long dropped = logUnregisteredDrops.load(std::memory_order_relaxed);
+    int count = std::min(ringCount.load(std::memory_order_acquire), MAX_LOG_THREADS);
+    for (int i = 0; i < count; ++i) {
+        dropped += rings[i].dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+// Costo de logEvent en el hilo que produce. Primero sin escritor: se llena
+// el anillo sin perder nada y se vacia aparte, asi solo se mide la
+// escritura del registro. Despues con el escritor, a ritmo de juego.
+void benchmarkLogger(int events) {
+    registerLogThread("bench");
+    output = nullptr;
+
+    double ms = 0.0;
+    int batch = LOG_RING_SIZE - 1;
+    for (int done = 0; done < events; done += batch) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < batch; ++i) {
+            logEvent(LOG_BLOCK_BROKEN, done + i, i >> 4);
+        }
+        ms += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        drainRings();
+    }
+    int logged = (events + batch - 1) / batch * batch;
+    long long droppedBurst = loggerDropped();
+
+    // Pocos eventos por frame con el escritor corriendo: no deberia perder ninguno
+    writerQuit = false;
+    writer = std::thread(writerLoop);
+    for (int f = 0; f < 200; ++f) {
+        setLogFrame(f);
+        for (int i = 0; i < 64; ++i) {
+            logEvent(LOG_PADDLE_BOUNCE, i, 0, 1.5f);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    writerQuit.store(true, std::memory_order_release);
+    writer.join();
+
+    std::printf("events,ns_per_event,written,dropped_burst,dropped_paced\n");
+    std::printf("%d,%.2f,%lld,%lld,%lld\n", logged, ms * 1e6 / logged, loggerWritten(), droppedBurst, loggerDropped() - droppedBurst);
+}
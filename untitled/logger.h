@@ -0,0 +1,92 @@
+#pragma once
+#include <SDL.h>
+#include <atomic>
+
+// Registro de eventos del juego. Cada hilo escribe registros binarios de
+// tamano fijo en su propio anillo (un productor, un consumidor) y un hilo
+// aparte les da formato y los escribe. En el hilo del juego solo cuesta
+// copiar 32 bytes y publicar el indice.
+const int LOG_RING_SIZE = 4096; // Potencia de dos
+const int MAX_LOG_THREADS = 8;
+
+enum LogEventType : Uint16 {
+    LOG_GAME_OVER,     // a = puntos
+    LOG_YOU_WIN,       // a = puntos
+    LOG_LIFE_LOST,     // a = vidas que quedan
+    LOG_BLOCK_BROKEN,  // a, b = posicion del bloque
+    LOG_PADDLE_BOUNCE, // a = x de la pelota, value = velocidad nueva
+    LOG_POWERUP,       // a = tipo
+    LOG_CHUNK_READY,   // a = id del chunk, value = ms de generacion
+    LOG_ASSET_READY,   // a = ranura, b = 1 si fallo, value = ms desde el pedido
+    LOG_LEVEL_SWITCH,  // a = nivel nuevo, value = ms del cambio
+    LOG_EVENT_TYPES
+};
+
+struct LogRecord {
+    Uint32 frame;
+    Uint32 sequence;
+    Uint16 type;
+    Uint16 thread;
+    Sint32 a;
+    Sint32 b;
+    float value;
+    Uint64 reserved;
+};
+static_assert(sizeof(LogRecord) == 32, "LogRecord must stay at 32 bytes");
+
+// Anillo de un hilo: head lo mueve solo el productor y tail solo el hilo
+// que escribe, cada uno en su propia linea de cache. El productor guarda
+// una copia de tail y solo relee la real cuando el anillo parece lleno.
+struct LogRing {
+    alignas(64) std::atomic<Uint32> head{0};
+    Uint32 cachedTail = 0;
+    alignas(64) std::atomic<Uint32> tail{0};
+    std::atomic<Uint32> dropped{0};
+    int thread = 0;
+    const char* name = "";
+    LogRecord records[LOG_RING_SIZE];
+};
+
+extern thread_local LogRing* logRing;
+extern std::atomic<Uint32> logFrame;
+extern std::atomic<Uint32> logUnregisteredDrops;
+
+bool startLogger(const char* path); // nullptr escribe en stdout
+void stopLogger();
+void registerLogThread(const char* name);
+long long loggerWritten();
+long long loggerDropped();
+
+// Sin anillo (hilo no registrado) o con el anillo lleno el registro se
+// descarta y se cuenta; nunca se bloquea ni se reserva memoria
+inline void logEvent(LogEventType type, int a = 0, int b = 0, float value = 0.0f) {
+    LogRing* ring = logRing;
+    if (!ring) {
+        logUnregisteredDrops.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Uint32 head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->cachedTail == LOG_RING_SIZE) {
+        ring->cachedTail = ring->tail.load(std::memory_order_acquire);
+        if (head - ring->cachedTail == LOG_RING_SIZE) {
+            // Solo este hilo lo escribe: no hace falta una operacion atomica completa
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    LogRecord& record = ring->records[head & (LOG_RING_SIZE - 1)];
+    record.frame = logFrame.load(std::memory_order_relaxed);
+    record.sequence = head;
+    record.type = type;
+    record.thread = static_cast<Uint16>(ring->thread);
+    record.a = a;
+    record.b = b;
+    record.value = value;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+inline void setLogFrame(Uint32 frame) {
+    logFrame.store(frame, std::memory_order_relaxed);
+}
+
+void benchmarkLogger(int events);
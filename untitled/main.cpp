@@ -8,6 +8,37 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include "particles.h"
+#include "stats.h"
+#include "text.h"
+#include "sprites.h"
+#include "cpu_renderer.h"
+#include "render_queue.h"
+#include "arena.h"
+#include "dirty_rects.h"
+#include "resolution.h"
+#include "blocks.h"
+#include "level.h"
+#include "bitboard.h"
+#include "ecs.h"
+#include "powerups.h"
+#include "camera.h"
+#include "endless.h"
+#include "allocations.h"
+#include "logger.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "bench.h"
+#include "stress.h"
+#include "audio.h"
+#include "asset_pack.h"
+#include "streaming.h"
+#include "startup.h"
 
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
@@ -21,6 +52,10 @@ const int BLOCK_ROWS = 5;
 const int BLOCK_COLUMNS = 10;
 const int BLOCK_WIDTH = SCREEN_WIDTH / BLOCK_COLUMNS;
 const int BLOCK_HEIGHT = 20;
+const int START_LIVES = 3;
+const int POINTS_PER_BLOCK = 10;
+const SDL_Color BLOCK_COLOR = {0x00, 0xFF, 0x00, 0xFF}; // Verde
+const SDL_Color PADDLE_COLOR = {0xFF, 0xFF, 0xFF, 0xFF}; // Blanco
 
 struct Rect {
     SDL_Rect rect = {0, 0, BALL_SIZE, BALL_SIZE};
@@ -29,142 +64,1804 @@ struct Rect {
     SDL_Color color = {0xFF, 0x00, 0x00, 0xFF}; // Rojo
 };
 
-struct Block {
-    SDL_Rect rect;
-    bool destroyed = false;
-};
+const Rect BALL_START = {{110, 110, BALL_SIZE, BALL_SIZE}, BALL_SPEED, BALL_SPEED, {0xFF, 0x00, 0x00, 0xFF}};//posicion inicial de la pelota
+const int MAX_BALLS = 16;
+
+// Pelotas, paddle, power-ups y disparos son entidades. Los bloques y las
+// particulas siguen en sus propias estructuras.
+const ComponentMask BALL_COMPONENTS = componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_VELOCITY) | componentBit(COMPONENT_SIZE) |
+                                      componentBit(COMPONENT_COLOR) | componentBit(COMPONENT_BALL);
+const ComponentMask PADDLE_COMPONENTS = componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_SIZE) | componentBit(COMPONENT_COLOR) |
+                                        componentBit(COMPONENT_PADDLE);
+EntityWorld entityWorld;
+Entity paddleEntity = INVALID_HANDLE;
+Level currentLevel;
+int blocksAlive = 0;
+
+// El nivel por defecto es una rejilla regular y se guarda como bitboard
+bool bitboardLevel = false;
+BitboardGrid wall;
+
+// El mundo puede ser mayor que la pantalla (--arena=N multiplica ambos lados)
+int arenaScale = 1;
+int worldWidth = SCREEN_WIDTH;
+int worldHeight = SCREEN_HEIGHT;
+Camera camera;
+
+// Modo sin fin: la pared baja continuamente y se genera por chunks
+bool endlessMode = false;
+Uint32 endlessSeed = 1;
+EndlessWorld endless;
+ParticlePool particles;
+GameStats stats;
+int score = 0;
+int lives = START_LIVES;
+int level = 1;
+
+// Paquete de assets (--pack=archivo); lo que no esta ahi se busca suelto
+AssetPack assetPack;
+// Carga en segundo plano del arte y del nivel siguiente de la lista
+// (--level= repetido); --sync-assets vuelve a cargar todo al iniciar
+AssetStreamer streamer;
+std::vector<const char*> levelPlaylist;
+int playlistIndex = 0;
+Handle nextLevelHandle = INVALID_HANDLE;
+Handle spriteArt[SPRITE_COUNT];
+SpriteAtlas spriteAtlas;
+CpuRenderer cpuRenderer;
+bool cpuBackend = false;
+FrameArena frameArena;
+RenderQueue renderQueue;
+
+// Despues del calentamiento el frame no debe reservar memoria en el heap.
+// En debug (o con --strict-allocations) una reserva termina el juego.
+const int ALLOCATION_WARMUP_FRAMES = 120;
+#ifdef NDEBUG
+bool strictAllocations = false;
+#else
+bool strictAllocations = true;
+#endif
+
+// Telemetria en memoria compartida (--telemetry[=nombre])
+Telemetry telemetry;
+
+// Fases del arranque hasta el primer frame (--startup-report las imprime)
+StartupTimeline startup;
+
+// Modo de rectangulos sucios
+bool dirtyRectMode = false;
+DirtyRects dirty;
+SDL_Rect previousEntities, previousPaddle, previousParticles;
+
+// Resolucion interna dinamica
+bool scaledRendering = false;
+ResolutionScaler scaler;
+
+// Campos del HUD
+GlyphAtlas glyphAtlas;
+TextBatch hud;
+int hudScore, hudLives, hudFps, hudLevel, hudStatus;
 
-Rect ball = {{110, 110, BALL_SIZE, BALL_SIZE}, BALL_SPEED, BALL_SPEED, {0xFF, 0x00, 0x00, 0xFF}};//posicion inicial de la pelota
-SDL_Rect paddle = {SCREEN_WIDTH / 2 - PADDLE_WIDTH / 2, SCREEN_HEIGHT - PADDLE_HEIGHT - 10, PADDLE_WIDTH, PADDLE_HEIGHT};
-std::vector<Block> blocks;
+const int DEBRIS_PER_BLOCK = 24;
+const int PARTICLE_STORM = 100000;
 
+// Power-ups que sueltan los bloques rotos
+const int POWERUP_CHANCE = 12; // Porcentaje de bloques que sueltan uno
+const float POWERUP_DURATION = 10.0f;
+const float LASER_COOLDOWN = 0.3f;
+float wideTimer = 0.0f;
+float laserTimer = 0.0f;
+float laserCooldown = 0.0f;
+Uint32 dropSeed = 0x2545F491u;
+
+// Nivel por defecto cuando no se pasa --level
 void createBlocks() {
-    for (int i = 0; i < BLOCK_ROWS; ++i) {
-        for (int j = 0; j < BLOCK_COLUMNS; ++j) {
-            blocks.push_back({{j * BLOCK_WIDTH, i * BLOCK_HEIGHT, BLOCK_WIDTH, BLOCK_HEIGHT}});
+    initBitboard(wall, BLOCK_COLUMNS * arenaScale, BLOCK_ROWS * arenaScale, BLOCK_WIDTH, BLOCK_HEIGHT);
+    bitboardLevel = true;
+    blocksAlive = bitboardCount(wall);
+}
+
+// El mismo nivel como tabla de bloques, para comparar en los benchmarks
+void createBlockLevel() {
+    int rows = BLOCK_ROWS * arenaScale;
+    int columns = BLOCK_COLUMNS * arenaScale;
+    currentLevel.blockStorage.reserve(rows * columns);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns; ++j) {
+            currentLevel.blockStorage.push_back({{j * BLOCK_WIDTH, i * BLOCK_HEIGHT, BLOCK_WIDTH, BLOCK_HEIGHT}});
         }
     }
+    currentLevel.attributeStorage.assign(currentLevel.blockStorage.size(), packBlockAttributes(1, BLOCK_NORMAL, 0));
+    currentLevel.palette[0] = BLOCK_COLOR;
+    currentLevel.paletteCount = 1;
+    useLevelStorage(currentLevel, worldWidth, worldHeight);
+    blocksAlive = currentLevel.breakable;
 }
 
-void renderRect(SDL_Renderer* renderer, Rect& rect) {
-    SDL_SetRenderDrawColor(renderer, rect.color.r, rect.color.g, rect.color.b, rect.color.a);
-    SDL_RenderFillRect(renderer, &rect.rect);
+SDL_Color blockColor(int i) {
+    return currentLevel.palette[blockPalette(currentLevel.attributes[i])];
 }
 
-void renderPaddle(SDL_Renderer* renderer, SDL_Rect& paddle) {
-    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF); // Blanco
-    SDL_RenderFillRect(renderer, &paddle);
+EntityInit ballInit(const Rect& ball) {
+    EntityInit init;
+    init.mask = BALL_COMPONENTS;
+    init.position = {static_cast<float>(ball.rect.x), static_cast<float>(ball.rect.y)};
+    init.velocity = {ball.vx, ball.vy};
+    init.size = {ball.rect.w, ball.rect.h};
+    init.color = ball.color;
+    return init;
 }
 
-void renderBlocks(SDL_Renderer* renderer) {
-    for (const auto& block : blocks) {
-        if (!block.destroyed) {
-            // Dibujar borde negro
-            SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF); // Negro
-            SDL_Rect borderRect = {block.rect.x - 1, block.rect.y - 1, block.rect.w + 2, block.rect.h + 2};
-            SDL_RenderFillRect(renderer, &borderRect);
+void spawnBall(const Rect& ball) {
+    createEntity(entityWorld, ballInit(ball));
+}
+
+void createPaddle() {
+    EntityInit init;
+    init.mask = PADDLE_COMPONENTS;
+    init.position = {static_cast<float>(worldWidth / 2 - PADDLE_WIDTH / 2), static_cast<float>(worldHeight - PADDLE_HEIGHT - 10)};
+    init.size = {PADDLE_WIDTH, PADDLE_HEIGHT};
+    init.color = PADDLE_COLOR;
+    paddleEntity = createEntity(entityWorld, init);
+}
 
-            // Dibujar bloque verde
-            SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF); // Verde
-            SDL_RenderFillRect(renderer, &block.rect);
+SDL_Rect paddleRect() {
+    return entityRect(*getComponent<Position>(entityWorld, paddleEntity, COMPONENT_POSITION),
+                      *getComponent<Size>(entityWorld, paddleEntity, COMPONENT_SIZE));
+}
+
+// Copia de la primera pelota en juego; false si no queda ninguna
+bool firstBall(Rect& ball) {
+    bool found = false;
+    forEachChunk(entityWorld, componentBit(COMPONENT_BALL), [&](const Archetype& archetype, EntityChunk& chunk) {
+        if (found || chunk.count == 0) {
+            return;
         }
+        const Velocity& velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY)[0];
+        ball.rect = entityRect(chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION)[0], chunkColumn<Size>(archetype, chunk, COMPONENT_SIZE)[0]);
+        ball.vx = velocity.x;
+        ball.vy = velocity.y;
+        ball.color = chunkColumn<SDL_Color>(archetype, chunk, COMPONENT_COLOR)[0];
+        found = true;
+    });
+    return found;
+}
+
+// Todas las entidades visibles. Con el backend de CPU todo se dibuja como
+// rectangulos solidos; si no, pelota y paddle usan su sprite.
+void renderEntities(RenderQueue& queue) {
+    PROFILE_ZONE("renderEntities");
+    const ComponentMask visible = componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_SIZE) | componentBit(COMPONENT_COLOR);
+    forEachChunk(entityWorld, visible, [&](const Archetype& archetype, EntityChunk& chunk) {
+        SpriteId sprite = (archetype.mask & componentBit(COMPONENT_BALL)) ? SPRITE_BALL
+                        : (archetype.mask & componentBit(COMPONENT_PADDLE)) ? SPRITE_PADDLE : SPRITE_COUNT;
+        const Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+        const Size* size = chunkColumn<Size>(archetype, chunk, COMPONENT_SIZE);
+        const SDL_Color* color = chunkColumn<SDL_Color>(archetype, chunk, COMPONENT_COLOR);
+        for (int i = 0; i < chunk.count; ++i) {
+            SDL_Rect screen = worldToScreen(camera, entityRect(position[i], size[i]));
+            if (cpuBackend || sprite == SPRITE_COUNT) {
+                queueRect(queue, LAYER_WORLD, screen, color[i]);
+            } else {
+                drawSprite(queue, spriteAtlas, sprite, screen, color[i]);
+            }
+        }
+    });
+}
+
+void renderBlock(RenderQueue& queue, const Block& block, SDL_Color color) {
+    SDL_Rect screen = worldToScreen(camera, block.rect);
+    if (cpuBackend) {
+        SDL_Rect borderRect = {screen.x - 1, screen.y - 1, screen.w + 2, screen.h + 2};
+        queueRect(queue, LAYER_BORDERS, borderRect, {0x00, 0x00, 0x00, 0xFF});
+        queueRect(queue, LAYER_WORLD, screen, color);
+    } else {
+        // El sprite ya incluye el borde negro
+        drawSprite(queue, spriteAtlas, SPRITE_BLOCK, screen, color);
     }
 }
 
-void update(float dT, bool& gameOver, bool& youWin) {
-    // Rebote en los bordes de la pantalla
-    if (ball.rect.x < 0 || ball.rect.x + ball.rect.w > SCREEN_WIDTH) {
-        ball.vx *= -1;
+// Solo los bloques dentro de la vista de la camara, consultando la rejilla
+void renderBlocks(RenderQueue& queue) {
+    PROFILE_ZONE("renderBlocks");
+    SDL_Rect view = cameraView(camera);
+    int visible = 0;
+    if (endlessMode) {
+        queryEndless(endless, view, [&](Chunk&, Block& block, const SDL_Rect& rect) {
+            renderBlock(queue, {rect, block.destroyed}, BLOCK_COLOR);
+            visible++;
+            return false;
+        });
+        stats.blocksVisible = visible;
+        return;
     }
-    if (ball.rect.y < 0) {
-        ball.vy *= -1;
+    if (bitboardLevel) {
+        forEachBitboardCell(wall, view, [&](int column, int row) {
+            renderBlock(queue, {bitboardCellRect(wall, column, row)}, BLOCK_COLOR);
+            visible++;
+        });
+        stats.blocksVisible = visible;
+        return;
     }
 
-    // Si la pelota toca la parte inferior de la pantalla
-    if (ball.rect.y + ball.rect.h > SCREEN_HEIGHT) {
-        gameOver = true;
-        std::cout << "Game Over" << std::endl;
+    // Los visibles se agrupan por color de paleta con un orden por conteo,
+    // asi cada color llega a la cola como un tramo contiguo
+    int limit = std::min(currentLevel.count, MAX_RENDER_COMMANDS);
+    int* found = arenaAllocArray<int>(*queue.arena, limit);
+    int* grouped = arenaAllocArray<int>(*queue.arena, limit);
+    int start[MAX_PALETTE_COLORS + 1] = {};
+    queryBlockGrid(currentLevel.grid, view, [&](int i) {
+        const Block& block = currentLevel.blocks[i];
+        if (block.destroyed || !SDL_HasIntersection(&block.rect, &view)) {
+            return false;
+        }
+        if (!found || !grouped) {
+            renderBlock(queue, block, blockColor(i));
+        } else if (visible < limit) {
+            found[visible] = i;
+            start[blockPalette(currentLevel.attributes[i]) + 1]++;
+        }
+        visible++;
+        return false;
+    });
+    if (found && grouped) {
+        int n = std::min(visible, limit);
+        for (int p = 1; p <= MAX_PALETTE_COLORS; ++p) {
+            start[p] += start[p - 1];
+        }
+        for (int k = 0; k < n; ++k) {
+            grouped[start[blockPalette(currentLevel.attributes[found[k]])]++] = found[k];
+        }
+        for (int k = 0; k < n; ++k) {
+            renderBlock(queue, currentLevel.blocks[grouped[k]], blockColor(grouped[k]));
+        }
     }
+    stats.blocksVisible = visible;
+}
 
-    // Rebote con el paddle
-    if (SDL_HasIntersection(&ball.rect, &paddle)) {
-        // Calcular el punto de impacto relativo en el paddle
-        float relativeIntersectX = (ball.rect.x + (BALL_SIZE / 2)) - (paddle.x + (paddle.w / 2));
-        float normalizedRelativeIntersectionX = relativeIntersectX / (paddle.w / 2);
-        float bounceAngle = normalizedRelativeIntersectionX * (M_PI / 4); // Ángulo máximo de 45 grados
+// Bloque roto en cualquiera de los modos: puntos, restos y quiza un power-up
+void onBlockBroken(const SDL_Rect& rect, SDL_Color color, int debris) {
+    score += POINTS_PER_BLOCK;
+    logEvent(LOG_BLOCK_BROKEN, rect.x, rect.y);
+    spawnBlockDebris(particles, rect, color, debris);
+    SDL_Rect screen = worldToScreen(camera, rect);
+    markDirty(dirty, {screen.x - 1, screen.y - 1, screen.w + 2, screen.h + 2});
 
-        // Ajustar velocidades de la pelota
-        ball.vx = BALL_SPEED * normalizedRelativeIntersectionX;
-        ball.vy = -BALL_SPEED * std::cos(bounceAngle);
+    dropSeed ^= dropSeed << 13;
+    dropSeed ^= dropSeed >> 17;
+    dropSeed ^= dropSeed << 5;
+    if (dropSeed % 100 < POWERUP_CHANCE) {
+        spawnPowerUp(entityWorld, rect.x + rect.w / 2.0f, static_cast<float>(rect.y), static_cast<PowerUpType>((dropSeed >> 8) % POWERUP_TYPES));
+    }
+}
 
-        // Aumentar la velocidad de la pelota
-        ball.vx *= 1.1f;
-        ball.vy *= 1.1f;
+// Paneo del sonido segun la posicion en pantalla
+float soundPan(const SDL_Rect& rect) {
+    SDL_Rect screen = worldToScreen(camera, rect);
+    return std::max(-1.0f, std::min(1.0f, (screen.x + screen.w / 2.0f) * 2.0f / SCREEN_WIDTH - 1.0f));
+}
 
-        ball.rect.y = paddle.y - ball.rect.h; // La pelota se mueva hacia arriba después de rebotar
+// Golpea el primer bloque que toca `area`, sea cual sea el almacenamiento
+// del nivel. La usan la pelota y los disparos del laser.
+bool hitBlock(const SDL_Rect& area) {
+    int debris = DEBRIS_PER_BLOCK * (scaler.effectQuality + 1) / (MAX_EFFECT_QUALITY + 1);
+    bool hit = false;
+    if (endlessMode) {
+        queryEndless(endless, area, [&](Chunk& chunk, Block& block, const SDL_Rect& rect) {
+            stats.collisionTests++;
+            if (!SDL_HasIntersection(&area, &rect)) {
+                return false;
+            }
+            block.destroyed = true;
+            chunk.alive--;
+            onBlockBroken(rect, BLOCK_COLOR, debris);
+            hit = true;
+            return true;
+        });
+        return hit;
     }
 
-    // Colisión con bloques
-    bool allBlocksDestroyed = true;
-    for (auto& block : blocks) {
-        if (!block.destroyed && SDL_HasIntersection(&ball.rect, &block.rect)) {
-            block.destroyed = true;
-            ball.vy *= -1;
-            break;
+    // Con bitboard la colision es aritmetica de bits sobre las celdas tocadas
+    if (bitboardLevel) {
+        SDL_Rect rect;
+        stats.collisionTests++;
+        if (bitboardHit(wall, area, rect)) {
+            blocksAlive--;
+            onBlockBroken(rect, BLOCK_COLOR, debris);
+            hit = true;
+        }
+        return hit;
+    }
+
+    // Nivel cargado: solo los bloques de las celdas que toca el area
+    queryBlockGrid(currentLevel.grid, area, [&](int i) {
+        Block& block = currentLevel.blocks[i];
+        stats.collisionTests++;
+        if (block.destroyed || !SDL_HasIntersection(&area, &block.rect)) {
+            return false;
+        }
+        hit = true;
+        // Los irrompibles solo rebotan; los de varios golpes pierden vida
+        BlockAttributes& attributes = currentLevel.attributes[i];
+        if (blockType(attributes) == BLOCK_UNBREAKABLE) {
+            return true;
         }
-        if (!block.destroyed) {
-            allBlocksDestroyed = false;
+        if (blockHitPoints(attributes) > 1) {
+            setBlockHitPoints(attributes, blockHitPoints(attributes) - 1);
+            return true;
         }
+
+        // Un explosivo puede romper muchos bloques: los restos se reparten
+        int broken = breakBlock(currentLevel, i);
+        blocksAlive -= broken;
+        for (int b : currentLevel.broken) {
+            onBlockBroken(currentLevel.blocks[b].rect, blockColor(b), std::max(1, debris / broken));
+        }
+        return true;
+    });
+    return hit;
+}
+
+// Bordes, paddle y bloques de cada pelota; las que caen se destruyen.
+// Devuelve cuantas siguen en juego.
+int updateBalls(const SDL_Rect& paddle) {
+    PROFILE_ZONE("collisions");
+    int inPlay = 0;
+    forEachChunk(entityWorld, componentBit(COMPONENT_BALL), [&](const Archetype& archetype, EntityChunk& chunk) {
+        Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+        Velocity* velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY);
+        const Size* size = chunkColumn<Size>(archetype, chunk, COMPONENT_SIZE);
+        const SDL_Color* color = chunkColumn<SDL_Color>(archetype, chunk, COMPONENT_COLOR);
+        Entity* entities = chunkEntities(chunk);
+        for (int i = 0; i < chunk.count; ++i) {
+            Velocity& ball = velocity[i];
+            SDL_Rect rect = entityRect(position[i], size[i]);
+
+            // Rebote en los bordes del mundo
+            if (rect.x < 0 || rect.x + rect.w > worldWidth) {
+                ball.x *= -1;
+            }
+            if (rect.y < 0) {
+                ball.y *= -1;
+            }
+
+            // Si la pelota toca la parte inferior del mundo
+            if (rect.y + rect.h > worldHeight) {
+                destroyEntity(entityWorld, entities[i]);
+                continue;
+            }
+            inPlay++;
+
+            // Rebote con el paddle
+            stats.collisionTests++;
+            if (SDL_HasIntersection(&rect, &paddle)) {
+                // Calcular el punto de impacto relativo en el paddle
+                float relativeIntersectX = (rect.x + (BALL_SIZE / 2)) - (paddle.x + (paddle.w / 2));
+                float normalizedRelativeIntersectionX = relativeIntersectX / (paddle.w / 2);
+                float bounceAngle = normalizedRelativeIntersectionX * (M_PI / 4); // Ángulo máximo de 45 grados
+
+                // Ajustar velocidades de la pelota
+                ball.x = BALL_SPEED * normalizedRelativeIntersectionX;
+                ball.y = -BALL_SPEED * std::cos(bounceAngle);
+
+                // Aumentar la velocidad de la pelota
+                ball.x *= 1.1f;
+                ball.y *= 1.1f;
+
+                rect.y = paddle.y - rect.h; // La pelota se mueva hacia arriba después de rebotar
+                position[i].y = static_cast<float>(rect.y);
+                logEvent(LOG_PADDLE_BOUNCE, rect.x, 0, std::sqrt(ball.x * ball.x + ball.y * ball.y));
+                playSound(SOUND_BOUNCE, 0.8f, soundPan(rect));
+            }
+
+            if (hitBlock(rect)) {
+                ball.y *= -1;
+                // Un sonido por golpe, aunque una explosion rompa muchos bloques
+                playSound(SOUND_HIT, 0.5f, soundPan(rect));
+            }
+
+            // Estela de la pelota, solo si la calidad de efectos lo permite
+            if (scaler.effectQuality > 0) {
+                spawnTrail(particles, rect, color[i]);
+            }
+        }
+    });
+    return inPlay;
+}
+
+// Mueve todo lo que tiene velocidad: pelotas, power-ups y disparos
+void moveEntities(float dT) {
+    const ComponentMask moving = componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_VELOCITY);
+    forEachChunk(entityWorld, moving, [&](const Archetype& archetype, EntityChunk& chunk) {
+        Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+        const Velocity* velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY);
+        for (int i = 0; i < chunk.count; ++i) {
+            position[i].x += velocity[i].x * dT;
+            position[i].y += velocity[i].y * dT;
+        }
+    });
+}
+
+void applyPowerUp(PowerUpType type) {
+    switch (type) {
+    case POWERUP_WIDE:
+        wideTimer = POWERUP_DURATION;
+        break;
+    case POWERUP_MULTIBALL: {
+        // Dos copias de la primera pelota, abiertas hacia los lados
+        Rect copy;
+        int balls = entityCount(entityWorld, componentBit(COMPONENT_BALL));
+        for (int k = 0; k < 2 && balls + k < MAX_BALLS && firstBall(copy); ++k) {
+            copy.vx = (k == 0 ? -1.0f : 1.0f) * std::max(std::fabs(copy.vx), BALL_SPEED * 0.5f);
+            copy.vy = -std::fabs(copy.vy);
+            spawnBall(copy);
+        }
+        break;
+    }
+    case POWERUP_SLOW:
+        forEachChunk(entityWorld, componentBit(COMPONENT_BALL), [](const Archetype& archetype, EntityChunk& chunk) {
+            Velocity* velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY);
+            for (int i = 0; i < chunk.count; ++i) {
+                velocity[i].x *= 0.7f;
+                velocity[i].y *= 0.7f;
+            }
+        });
+        break;
+    case POWERUP_LASER:
+        laserTimer = POWERUP_DURATION;
+        break;
+    default:
+        break;
+    }
+}
+
+// Power-ups atrapados, efectos con tiempo y disparos del laser
+void updatePowerUpEffects(float dT, const SDL_Rect& paddle) {
+    PROFILE_ZONE("powerUps");
+    PowerUpType collected[8];
+    int caught = collectPowerUps(entityWorld, paddle, worldHeight, collected, 8);
+    for (int k = 0; k < caught; ++k) {
+        logEvent(LOG_POWERUP, collected[k]);
+        applyPowerUp(collected[k]);
+    }
+
+    wideTimer = std::max(0.0f, wideTimer - dT);
+    int width = wideTimer > 0.0f ? PADDLE_WIDTH * 3 / 2 : PADDLE_WIDTH;
+    Position& position = *getComponent<Position>(entityWorld, paddleEntity, COMPONENT_POSITION);
+    Size& size = *getComponent<Size>(entityWorld, paddleEntity, COMPONENT_SIZE);
+    if (size.w != width) {
+        position.x -= (width - size.w) / 2.0f;
+        size.w = width;
+        position.x = std::max(0.0f, std::min(static_cast<float>(worldWidth - size.w), position.x));
+    }
+
+    laserTimer = std::max(0.0f, laserTimer - dT);
+    laserCooldown -= dT;
+    if (laserTimer > 0.0f && laserCooldown <= 0.0f) {
+        float y = position.y - LASER_HEIGHT;
+        fireLaser(entityWorld, position.x + 4, y);
+        fireLaser(entityWorld, position.x + size.w - 4 - LASER_WIDTH, y);
+        laserCooldown = LASER_COOLDOWN;
     }
+    hitLaserShots(entityWorld, hitBlock);
+}
+
+void update(float dT, bool& gameOver, bool& youWin) {
+    PROFILE_ZONE("update");
+    stats.collisionTests = 0;
+    SDL_Rect paddle = paddleRect();
+
+    // Perder la ultima pelota cuesta una vida
+    if (updateBalls(paddle) == 0) {
+        lives--;
+        logEvent(LOG_LIFE_LOST, std::max(0, lives));
+        if (lives <= 0) {
+            lives = 0;
+            gameOver = true;
+            logEvent(LOG_GAME_OVER, score);
+            playSound(SOUND_GAME_OVER);
+        } else {
+            spawnBall(BALL_START);
+        }
+    }
+
+    // En el modo sin fin se pierde si la pared llega al paddle
+    if (endlessMode && endlessWallBottom(endless) >= paddle.y) {
+        gameOver = true;
+        logEvent(LOG_GAME_OVER, score);
+        playSound(SOUND_GAME_OVER);
+    }
+
+    Uint64 powerUpStart = SDL_GetPerformanceCounter();
+    updatePowerUpEffects(dT, paddle);
+    stats.powerUpMs = (SDL_GetPerformanceCounter() - powerUpStart) * 1000.0f / SDL_GetPerformanceFrequency();
+
+    // Los cambios estructurales del tick se aplican despues de mover
+    moveEntities(dT);
+    flushEntityCommands(entityWorld);
+    stats.balls = entityCount(entityWorld, componentBit(COMPONENT_BALL));
+    stats.powerUps = entityCount(entityWorld, componentBit(COMPONENT_POWERUP));
+    stats.laserShots = entityCount(entityWorld, componentBit(COMPONENT_LASER));
+    stats.entities = entityCount(entityWorld, 0);
+    stats.entityChunks = entityChunkCount(entityWorld);
 
-    if (allBlocksDestroyed) {
+    bool cleared = bitboardLevel ? bitboardEmpty(wall) : blocksAlive == 0;
+    if (!endlessMode && cleared) {
         youWin = true;
-        std::cout << "You Win!" << std::endl;
+        logEvent(LOG_YOU_WIN, score);
     }
+}
+
+// false si no se pudo crear el atlas de glifos
+bool createHud(SDL_Renderer* renderer) {
+    const SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+    const SDL_Color yellow = {0xFF, 0xD0, 0x40, 0xFF};
+    const int cell = GLYPH_CELL_W * TEXT_SCALE;
+    const int y = BLOCK_ROWS * BLOCK_HEIGHT + 8;
+
+    if (!createGlyphAtlas(renderer, glyphAtlas)) {
+        return false;
+    }
+
+    // Las etiquetas se escriben una sola vez
+    setText(hud, glyphAtlas, addTextField(hud, 8, y, 6, white), "SCORE");
+    hudScore = addTextField(hud, 8 + 6 * cell, y, 7, yellow);
+    setText(hud, glyphAtlas, addTextField(hud, 8, y + 20, 6, white), "LIVES");
+    hudLives = addTextField(hud, 8 + 6 * cell, y + 20, 2, yellow);
+    setText(hud, glyphAtlas, addTextField(hud, SCREEN_WIDTH - 14 * cell, y, 6, white), "LEVEL");
+    hudLevel = addTextField(hud, SCREEN_WIDTH - 8 * cell, y, 3, yellow);
+    setText(hud, glyphAtlas, addTextField(hud, SCREEN_WIDTH - 14 * cell, y + 20, 4, white), "FPS");
+    hudFps = addTextField(hud, SCREEN_WIDTH - 8 * cell, y + 20, 4, yellow);
+    hudStatus = addTextField(hud, SCREEN_WIDTH / 2 - 9 * cell / 2, SCREEN_HEIGHT / 2, 9, white);
+    return true;
+}
 
-    ball.rect.x += ball.vx * dT;
-    ball.rect.y += ball.vy * dT;
+void updateHud(bool gameOver, bool youWin) {
+    // setText solo vuelve a generar los digitos que cambiaron
+    setNumber(hud, glyphAtlas, hudScore, score);
+    setNumber(hud, glyphAtlas, hudLives, lives);
+    setNumber(hud, glyphAtlas, hudLevel, level);
+    setNumber(hud, glyphAtlas, hudFps, stats.fps);
+    setText(hud, glyphAtlas, hudStatus, gameOver ? "GAME OVER" : youWin ? "YOU WIN!" : "");
+}
+
+// Copia las estadisticas del frame al bloque compartido; sin lectores
+// cuesta lo mismo, el juego nunca los espera
+void publishFrameTelemetry(Uint64 frame, Uint64 ticks) {
+    TelemetryValues values = {};
+    values.frame = frame;
+    values.ticks = ticks;
+    values.frameMs = stats.frameMs;
+    values.frameMsMax = stats.frameMsMax;
+    values.ticksPerSecond = stats.ticksPerSecond;
+    values.fps = stats.fps;
+    values.collisionTests = stats.collisionTests;
+    values.blocksAlive = endlessMode ? endlessAlive(endless) : blocksAlive;
+    values.drawCalls = stats.drawCalls;
+    values.stateChanges = stats.stateChanges;
+    values.entities = stats.entities;
+    values.particles = particles.count;
+    values.frameAllocations = stats.frameAllocations;
+    values.heapAllocations = heapAllocationCount();
+    values.logDropped = loggerDropped();
+    publishTelemetry(telemetry, values);
+}
+
+// Lo que se movio o cambio desde el frame anterior
+void trackDirtyRegions() {
+    PROFILE_ZONE("trackDirtyRegions");
+    // Pelotas, power-ups y disparos: todo lo que tiene velocidad
+    SDL_Rect moving = entityBounds(entityWorld, componentBit(COMPONENT_VELOCITY));
+    SDL_Rect entityArea = moving.w > 0 ? worldToScreen(camera, moving) : SDL_Rect{0, 0, 0, 0};
+    SDL_Rect paddleArea = worldToScreen(camera, paddleRect());
+    SDL_Rect particleArea = particles.count > 0 ? worldToScreen(camera, particleBounds(particles)) : SDL_Rect{0, 0, 0, 0};
+    markDirtyMove(dirty, previousEntities, entityArea);
+    markDirtyMove(dirty, previousPaddle, paddleArea);
+    markDirtyMove(dirty, previousParticles, particleArea);
+    previousEntities = entityArea;
+    previousPaddle = paddleArea;
+    previousParticles = particleArea;
+
+    for (auto& field : hud.fields) {
+        if (field.dirty) {
+            markDirty(dirty, textFieldBounds(field));
+            field.dirty = false;
+        }
+    }
 }
 
 void handleInput(float dT) {
+    PROFILE_ZONE("handleInput");
     const Uint8* ks = SDL_GetKeyboardState(NULL);
+    Position& paddle = *getComponent<Position>(entityWorld, paddleEntity, COMPONENT_POSITION);
+    int paddleWidth = getComponent<Size>(entityWorld, paddleEntity, COMPONENT_SIZE)->w;
 
     if (ks[SDL_SCANCODE_LEFT]) {
-        paddle.x -= PADDLE_SPEED * dT;
+        paddle.x -= PADDLE_SPEED * arenaScale * dT;
     }
     if (ks[SDL_SCANCODE_RIGHT]) {
-        paddle.x += PADDLE_SPEED * dT;
+        paddle.x += PADDLE_SPEED * arenaScale * dT;
     }
 
     if (paddle.x < 0) paddle.x = 0;
-    if (paddle.x > SCREEN_WIDTH - PADDLE_WIDTH) paddle.x = SCREEN_WIDTH - PADDLE_WIDTH;
+    if (paddle.x > worldWidth - paddleWidth) paddle.x = worldWidth - paddleWidth;
+}
+
+void setupWorld(int width, int height) {
+    arenaScale = std::max(1, width / SCREEN_WIDTH);
+    worldWidth = std::max(SCREEN_WIDTH, width);
+    worldHeight = std::max(SCREEN_HEIGHT, height);
+    camera.viewWidth = SCREEN_WIDTH;
+    camera.viewHeight = SCREEN_HEIGHT;
+    camera.x = worldWidth / 2.0f;
+    camera.y = worldHeight / 2.0f;
+}
+
+// Pide el nivel que sigue en la lista mientras se juega el actual
+void requestNextLevel() {
+    nextLevelHandle = INVALID_HANDLE;
+    if (playlistIndex + 1 < static_cast<int>(levelPlaylist.size())) {
+        nextLevelHandle = requestLevel(streamer, levelPlaylist[playlistIndex + 1]);
+    }
+}
+
+// Pasa al nivel precargado sin tocar el disco; false si todavia no llego
+bool switchToNextLevel() {
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (!takeStreamedLevel(streamer, nextLevelHandle, currentLevel)) {
+        return false;
+    }
+    // El nivel viejo quedo en el asset y se libera con el handle
+    releaseAsset(streamer, nextLevelHandle);
+    playlistIndex++;
+    level++;
+    bitboardLevel = false;
+    blocksAlive = currentLevel.breakable;
+    setupWorld(currentLevel.worldWidth, currentLevel.worldHeight);
+
+    // Pelotas, power-ups y disparos del nivel anterior
+    forEachChunk(entityWorld, componentBit(COMPONENT_VELOCITY), [&](const Archetype&, EntityChunk& chunk) {
+        const Entity* entities = chunkEntities(chunk);
+        for (int i = 0; i < chunk.count; ++i) {
+            destroyEntity(entityWorld, entities[i]);
+        }
+    });
+    flushEntityCommands(entityWorld);
+    wideTimer = laserTimer = laserCooldown = 0.0f;
+    Position* paddle = getComponent<Position>(entityWorld, paddleEntity, COMPONENT_POSITION);
+    paddle->x = static_cast<float>(worldWidth / 2 - PADDLE_WIDTH / 2);
+    paddle->y = static_cast<float>(worldHeight - PADDLE_HEIGHT - 10);
+    spawnBall(BALL_START);
+    flushEntityCommands(entityWorld);
+    particles.count = 0;
+    markFullDirty(dirty);
+    followCamera(camera, worldWidth / 2.0f, worldHeight / 2.0f, worldWidth, worldHeight, 1.0f);
+
+    requestNextLevel();
+    logEvent(LOG_LEVEL_SWITCH, level, 0, (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency());
+    return true;
+}
+
+// Costo de grabar los bloques con y sin la rejilla en un mundo de ~1M bloques
+void benchmarkCulling() {
+    const float zooms[] = {1.0f, 0.25f, 0.05f};
+    const int frames = 50;
+    // Sin --level se usa el nivel por defecto ampliado a ~1M bloques
+    bool standard = currentLevel.count == 0;
+    if (standard) {
+        setupWorld(SCREEN_WIDTH * 142, SCREEN_HEIGHT * 142);
+        createBlockLevel();
+        initBitboard(wall, BLOCK_COLUMNS * arenaScale, BLOCK_ROWS * arenaScale, BLOCK_WIDTH, BLOCK_HEIGHT);
+    }
+    initFrameArena(frameArena, RENDER_ARENA_SIZE);
+    Uint32 seed = 12345;
+    // Las camaras se reparten sobre la franja con bloques (5 filas de 480 px)
+    int wallHeight = worldHeight * BLOCK_ROWS * BLOCK_HEIGHT / SCREEN_HEIGHT;
+
+    std::printf("blocks,zoom,visible,brute_visible,bitboard_visible,culled_ms,brute_ms,bitboard_ms\n");
+    for (float zoom : zooms) {
+        camera.zoom = zoom;
+        double culledMs = 0.0, bruteMs = 0.0, bitboardMs = 0.0;
+        int culledVisible = 0, bruteVisible = 0, bitboardVisible = 0;
+        for (int f = 0; f < frames; ++f) {
+            seed = seed * 1664525u + 1013904223u;
+            float cx = static_cast<float>((seed >> 8) % worldWidth);
+            float cy = static_cast<float>((seed >> 4) % wallHeight);
+            followCamera(camera, cx, cy, worldWidth, worldHeight, 1.0f);
+
+            resetFrameArena(frameArena);
+            beginRenderQueue(renderQueue, frameArena);
+            Uint64 start = SDL_GetPerformanceCounter();
+            renderBlocks(renderQueue);
+            culledVisible += stats.blocksVisible;
+            culledMs += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+            resetFrameArena(frameArena);
+            beginRenderQueue(renderQueue, frameArena);
+            start = SDL_GetPerformanceCounter();
+            SDL_Rect view = cameraView(camera);
+            for (int i = 0; i < currentLevel.count; ++i) {
+                const Block& block = currentLevel.blocks[i];
+                if (!block.destroyed && SDL_HasIntersection(&block.rect, &view)) {
+                    renderBlock(renderQueue, block, blockColor(i));
+                    bruteVisible++;
+                }
+            }
+            bruteMs += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+            if (standard) {
+                resetFrameArena(frameArena);
+                beginRenderQueue(renderQueue, frameArena);
+                bitboardLevel = true;
+                start = SDL_GetPerformanceCounter();
+                renderBlocks(renderQueue);
+                bitboardMs += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+                bitboardVisible += stats.blocksVisible;
+                bitboardLevel = false;
+            }
+        }
+        std::printf("%d,%.2f,%d,%d,%d,%.3f,%.3f,%.3f\n", currentLevel.count, zoom, culledVisible / frames, bruteVisible / frames, bitboardVisible / frames,
+                    culledMs / frames, bruteMs / frames, bitboardMs / frames);
+    }
+}
+
+// Costo de una reaccion en cadena en un nivel de ~1M bloques, con
+// distintas proporciones de explosivos alrededor del umbral de percolacion
+void benchmarkChain() {
+    const int explosivePercents[] = {10, 30, 45, 60, 100};
+    setupWorld(SCREEN_WIDTH * 142, SCREEN_HEIGHT * 142);
+    createBlockLevel();
+    currentLevel.palette[1] = {0x80, 0x80, 0x80, 0xFF};
+    currentLevel.palette[2] = {0xFF, 0x40, 0x20, 0xFF};
+    currentLevel.paletteCount = 3;
+
+    std::printf("blocks,explosive_pct,broken,chain_ms,ns_per_block\n");
+    for (int percent : explosivePercents) {
+        Uint32 seed = 12345;
+        for (int i = 0; i < currentLevel.count; ++i) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            int roll = static_cast<int>(seed % 1000);
+            currentLevel.blocks[i].destroyed = false;
+            currentLevel.attributes[i] = roll < percent * 10 ? packBlockAttributes(1, BLOCK_EXPLOSIVE, 2)
+                                         : roll >= 980 ? packBlockAttributes(1, BLOCK_UNBREAKABLE, 1)
+                                                       : packBlockAttributes(1, BLOCK_NORMAL, 0);
+        }
+        // Detonacion en el centro de la pared
+        int center = (BLOCK_ROWS * arenaScale / 2) * BLOCK_COLUMNS * arenaScale + BLOCK_COLUMNS * arenaScale / 2;
+        currentLevel.attributes[center] = packBlockAttributes(1, BLOCK_EXPLOSIVE, 2);
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        int broken = breakBlock(currentLevel, center);
+        double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        std::printf("%d,%d,%d,%.3f,%.1f\n", currentLevel.count, percent, broken, ms, ms * 1e6 / broken);
+    }
+}
+
+// Flujo de chunks a velocidad alta, con la pared y el render de bloques.
+// Despues del calentamiento no deberia haber ninguna reserva en el heap.
+void benchmarkEndless() {
+    const int warmup = 120;
+    const int frames = 6000;
+    const float dT = 1.0f / MAX_FPS;
+    setupWorld(SCREEN_WIDTH * arenaScale, SCREEN_HEIGHT * arenaScale);
+    initFrameArena(frameArena, RENDER_ARENA_SIZE);
+    initEndless(endless, endlessSeed, BLOCK_COLUMNS * arenaScale, BLOCK_WIDTH, BLOCK_HEIGHT, worldHeight, BLOCK_ROWS * BLOCK_HEIGHT);
+    endless.speed = 40.0f * endless.chunkHeight; // Varios chunks por segundo
+    camera.y = worldHeight / 2.0f;
+
+    long long warmupAllocations = 0;
+    long long start = heapAllocationCount();
+    Uint64 begin = 0;
+    for (int f = 0; f < warmup + frames; ++f) {
+        if (f == warmup) {
+            warmupAllocations = heapAllocationCount() - start;
+            start = heapAllocationCount();
+            begin = SDL_GetPerformanceCounter();
+        }
+        updateEndless(endless, dT);
+        resetFrameArena(frameArena);
+        beginRenderQueue(renderQueue, frameArena);
+        renderBlocks(renderQueue);
+        // Sin generador rapido la pared se quedaria sin chunks; se espera un poco
+        if (endless.readyCount == 0) {
+            std::this_thread::yield();
+        }
+    }
+    double totalMs = (SDL_GetPerformanceCounter() - begin) * 1000.0 / SDL_GetPerformanceFrequency();
+    long long steadyAllocations = heapAllocationCount() - start;
+
+    std::printf("frames,chunks,recycled,stalls,gen_ms,max_gen_ms,frame_ms,warmup_allocs,steady_allocs\n");
+    std::printf("%d,%d,%d,%d,%.4f,%.4f,%.4f,%lld,%lld\n", frames, endless.generated, endless.recycled, endless.stalls,
+                endless.generationMs, endless.maxGenerationMs, totalMs / frames, warmupAllocations, steadyAllocations);
+    destroyEndless(endless);
+    unloadLevel(currentLevel);
+}
+
+// Recorrido de muchas pelotas como entidades frente al arreglo de Rect de
+// antes. "move" es lo que hace moveEntities (solo posicion y velocidad);
+// "bounce" ademas rebota en los bordes y lee el tamano.
+void benchmarkEntities() {
+    const int count = 60000;
+    const int steps = 1000;
+    const float dT = 1.0f / MAX_FPS;
+    const int width = worldWidth, height = worldHeight; // Locales: las columnas int podrian apuntar a los globales
+    EntityWorld world;
+    initEntityWorld(world, count);
+    std::vector<Rect> rects(count);
+    Uint32 seed = 0x9E3779B9u;
+    for (int i = 0; i < count; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        Rect& ball = rects[i];
+        ball.rect.x = static_cast<int>(seed % (width - BALL_SIZE));
+        ball.rect.y = static_cast<int>((seed >> 8) % (height - BALL_SIZE));
+        ball.vx = (seed & 1) ? BALL_SPEED : -BALL_SPEED;
+        ball.vy = (seed & 2) ? BALL_SPEED : -BALL_SPEED;
+        createEntity(world, ballInit(ball));
+    }
+    flushEntityCommands(world);
+    std::vector<Rect> start = rects;
+    const ComponentMask ball = componentBit(COMPONENT_BALL);
+
+    auto moveRects = [&]() {
+        for (Rect& r : rects) {
+            r.rect.x += r.vx * dT;
+            r.rect.y += r.vy * dT;
+        }
+    };
+    auto bounceRects = [&]() {
+        for (Rect& r : rects) {
+            r.rect.x += r.vx * dT;
+            r.rect.y += r.vy * dT;
+            if (r.rect.x < 0 || r.rect.x + r.rect.w > width) r.vx = -r.vx;
+            if (r.rect.y < 0 || r.rect.y + r.rect.h > height) r.vy = -r.vy;
+        }
+    };
+    auto moveChunks = [&]() {
+        forEachChunk(world, ball, [&](const Archetype& archetype, EntityChunk& chunk) {
+            Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+            const Velocity* velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY);
+            for (int i = 0; i < chunk.count; ++i) {
+                position[i].x += velocity[i].x * dT;
+                position[i].y += velocity[i].y * dT;
+            }
+        });
+    };
+    auto bounceChunks = [&]() {
+        forEachChunk(world, ball, [&](const Archetype& archetype, EntityChunk& chunk) {
+            Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+            Velocity* velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY);
+            const Size* size = chunkColumn<Size>(archetype, chunk, COMPONENT_SIZE);
+            for (int i = 0; i < chunk.count; ++i) {
+                position[i].x += velocity[i].x * dT;
+                position[i].y += velocity[i].y * dT;
+                if (position[i].x < 0 || position[i].x + size[i].w > width) velocity[i].x = -velocity[i].x;
+                if (position[i].y < 0 || position[i].y + size[i].h > height) velocity[i].y = -velocity[i].y;
+            }
+        });
+    };
+    // Cada medicion empieza con las mismas pelotas dentro del mundo
+    auto reset = [&]() {
+        rects = start;
+        int i = 0;
+        forEachChunk(world, ball, [&](const Archetype& archetype, EntityChunk& chunk) {
+            Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+            Velocity* velocity = chunkColumn<Velocity>(archetype, chunk, COMPONENT_VELOCITY);
+            for (int k = 0; k < chunk.count; ++k, ++i) {
+                position[k] = {static_cast<float>(start[i].rect.x), static_cast<float>(start[i].rect.y)};
+                velocity[k] = {start[i].vx, start[i].vy};
+            }
+        });
+    };
+    auto measure = [&](auto&& pass) {
+        reset();
+        Uint64 begin = SDL_GetPerformanceCounter();
+        for (int s = 0; s < steps; ++s) {
+            pass();
+        }
+        double ms = (SDL_GetPerformanceCounter() - begin) * 1000.0 / SDL_GetPerformanceFrequency();
+        return ms * 1e6 / (static_cast<double>(count) * steps);
+    };
+
+    double rectMove = measure(moveRects);
+    double ecsMove = measure(moveChunks);
+    double rectBounce = measure(bounceRects);
+    double ecsBounce = measure(bounceChunks);
+
+    // La suma evita que el compilador descarte los recorridos
+    double checksum = 0.0;
+    for (const Rect& r : rects) {
+        checksum += r.rect.x;
+    }
+    forEachChunk(world, ball, [&](const Archetype& archetype, EntityChunk& chunk) {
+        const Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+        for (int i = 0; i < chunk.count; ++i) {
+            checksum += position[i].x;
+        }
+    });
+
+    std::printf("entities,chunks,per_chunk,steps,rect_move_ns,ecs_move_ns,rect_bounce_ns,ecs_bounce_ns,checksum\n");
+    std::printf("%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.0f\n", count, entityChunkCount(world), world.archetypes[0].capacity, steps, rectMove, ecsMove, rectBounce, ecsBounce, checksum);
+}
+
+// Partida nueva sin ventana: mundo de `scale` x `scale` pantallas con el
+// nivel por defecto, el paddle y `balls` pelotas repartidas por la pared.
+// Las pelotas, la semilla de los power-ups y todo lo demas es fijo.
+void resetHeadlessGame(int scale, int balls) {
+    unloadLevel(currentLevel);
+    setupWorld(SCREEN_WIDTH * scale, SCREEN_HEIGHT * scale);
+    createBlocks();
+    particles.count = 0;
+    clearDirtyRects(dirty);
+    initEntityWorld(entityWorld, MAX_ENTITIES);
+    reserveEntities(entityWorld, PADDLE_COMPONENTS, 1);
+    reserveEntities(entityWorld, BALL_COMPONENTS, MAX_BALLS);
+    reserveEntities(entityWorld, POWERUP_COMPONENTS, MAX_POWERUPS);
+    reserveEntities(entityWorld, LASER_COMPONENTS, MAX_LASER_SHOTS);
+    createPaddle();
+    for (int b = 0; b < balls; ++b) {
+        Rect ball = BALL_START;
+        ball.rect.x = (BALL_START.rect.x + b * 97 * scale) % (worldWidth - BALL_SIZE);
+        ball.vx = b % 2 ? -BALL_SPEED : BALL_SPEED;
+        spawnBall(ball);
+    }
+    flushEntityCommands(entityWorld);
+    score = 0;
+    lives = START_LIVES;
+    dropSeed = 0x2545F491u;
+    wideTimer = laserTimer = laserCooldown = 0.0f;
+    followCamera(camera, worldWidth / 2.0f, SCREEN_HEIGHT / 2.0f, worldWidth, worldHeight, 1.0f);
+}
+
+// Paddle automatico para las partidas sin ventana: sigue a la primera pelota
+void autopilotPaddle() {
+    Rect ball;
+    if (!firstBall(ball)) {
+        return;
+    }
+    Position& paddle = *getComponent<Position>(entityWorld, paddleEntity, COMPONENT_POSITION);
+    int paddleWidth = getComponent<Size>(entityWorld, paddleEntity, COMPONENT_SIZE)->w;
+    float target = ball.rect.x + ball.rect.w / 2.0f - paddleWidth / 2.0f;
+    paddle.x = std::max(0.0f, std::min(static_cast<float>(worldWidth - paddleWidth), target));
+}
+
+struct StressScenario {
+    const char* name;
+    int scale;        // Pantallas por lado del mundo
+    int balls;
+    int ticks;
+    int stormEvery;   // Cada cuantos ticks se lanza una tormenta de particulas; 0 nunca
+};
+
+// Matriz de escenarios de estres (--stress). Cada tick es lo que hace el
+// juego sin el render: paddle, simulacion, particulas y camara. Si la
+// partida termina se empieza otra igual, fuera del tiempo medido y sin
+// contar sus reservas (rearma el mundo). Con --stress-baseline sale con
+// error si alguna metrica empeora mas que --stress-threshold.
+int runStressScenarios(const char* baselinePath, double threshold) {
+    const StressScenario scenarios[] = {
+        {"many_balls", 4, MAX_BALLS, 60000, 0},
+        {"huge_level", 64, 4, 60000, 0},
+        {"long_session", 1, 1, 600000, 0},
+        {"particle_storm", 4, 4, 3000, 60},
+    };
+    const float dT = 1.0f / MAX_FPS;
+    initParticles(particles, MAX_PARTICLES);
+    std::vector<StressResult> results;
+    std::vector<float> tickMs;
+
+    std::printf("%-20s %8s %12s %10s %10s %8s\n", "scenario", "ticks", "ticks/s", "p99_ms", "rss_kb", "allocs");
+    for (const StressScenario& scenario : scenarios) {
+        resetHeadlessGame(scenario.scale, scenario.balls);
+        tickMs.assign(scenario.ticks, 0.0f);
+        resetPeakResident();
+        long long allocationMark = 0;
+        Uint64 paused = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int t = 0; t < scenario.ticks; ++t) {
+            if (t == ALLOCATION_WARMUP_FRAMES) {
+                allocationMark = heapAllocationCount();
+            }
+            Uint64 tickStart = SDL_GetPerformanceCounter();
+            bool gameOver = false, youWin = false;
+            autopilotPaddle();
+            if (scenario.stormEvery > 0 && t % scenario.stormEvery == 0) {
+                spawnBlockDebris(particles, {0, 0, worldWidth, worldHeight / 2}, {0xFF, 0xA0, 0x20, 0xFF}, PARTICLE_STORM);
+            }
+            update(dT, gameOver, youWin);
+            updateParticles(particles, dT);
+            Rect followed;
+            if (firstBall(followed)) {
+                followCamera(camera, followed.rect.x + followed.rect.w / 2.0f, followed.rect.y + followed.rect.h / 2.0f, worldWidth, worldHeight, dT);
+            }
+            Uint64 tickEnd = SDL_GetPerformanceCounter();
+            tickMs[t] = (tickEnd - tickStart) * 1000.0f / SDL_GetPerformanceFrequency();
+            if (gameOver || youWin) {
+                long long allocationsBefore = heapAllocationCount();
+                resetHeadlessGame(scenario.scale, scenario.balls);
+                if (t >= ALLOCATION_WARMUP_FRAMES) {
+                    allocationMark += heapAllocationCount() - allocationsBefore;
+                }
+                paused += SDL_GetPerformanceCounter() - tickEnd;
+            }
+        }
+        double seconds = (SDL_GetPerformanceCounter() - start - paused) / static_cast<double>(SDL_GetPerformanceFrequency());
+
+        StressResult result = {};
+        std::snprintf(result.name, sizeof(result.name), "%s", scenario.name);
+        result.ticks = scenario.ticks;
+        result.ticksPerSecond = scenario.ticks / seconds;
+        result.p99TickMs = percentile(tickMs, 0.99);
+        result.peakRssKb = peakResidentKb();
+        result.allocations = heapAllocationCount() - allocationMark;
+        printStressResult(result);
+        results.push_back(result);
+    }
+    unloadLevel(currentLevel);
+
+    if (!writeStressCsv("stress.csv", results) || !writeStressJson("stress.json", results)) {
+        return -1;
+    }
+    std::cout << "Results written to stress.csv and stress.json" << std::endl;
+    if (!baselinePath) {
+        return 0;
+    }
+    std::vector<StressResult> baseline;
+    if (!loadStressBaseline(baselinePath, baseline)) {
+        return -1;
+    }
+    int regressions = compareStress(results, baseline, threshold);
+    std::cout << regressions << " regressions against " << baselinePath << " (threshold " << threshold * 100 << "%)" << std::endl;
+    return regressions > 0 ? 1 : 0;
 }
 
-int main() {
+// Suite de microbenchmarks (--bench-suite[=archivo.json]): simulacion,
+// colisiones, creacion del nivel, render de bloques con el renderer por
+// software y entrada. Corre con el driver de video dummy.
+bool benchmarkSuite(const char* jsonPath) {
+    const int scales[] = {1, 4, 16, 64}; // 50 bloques por pantalla
+    const float dT = 1.0f / MAX_FPS;
+    std::vector<BenchResult> results;
+    bool gameOver = false, youWin = false;
+    initParticles(particles, MAX_PARTICLES);
+    initFrameArena(frameArena, RENDER_ARENA_SIZE);
+    printBenchHeader();
+
+    for (int scale : scales) {
+        int blocks = BLOCK_COLUMNS * BLOCK_ROWS * scale * scale;
+        int iterations = std::max(1, 4096 / (scale * scale));
+        results.push_back(runBench("createBlocks", blocks, iterations, [&] { setupWorld(SCREEN_WIDTH * scale, SCREEN_HEIGHT * scale); },
+                                   [&](int) { createBlocks(); }));
+    }
+
+    for (int scale : scales) {
+        int blocks = BLOCK_COLUMNS * BLOCK_ROWS * scale * scale;
+        results.push_back(runBench("update", blocks, 600, [&] { resetHeadlessGame(scale, MAX_BALLS / 2); },
+                                   [&](int) { update(dT, gameOver, youWin); }));
+    }
+
+    // Areas del tamano de una pelota sobre la pared; cada repeticion las
+    // recorre en el mismo orden y empieza con el nivel completo
+    for (int grid = 0; grid < 2; ++grid) {
+        for (int scale : scales) {
+            int blocks = BLOCK_COLUMNS * BLOCK_ROWS * scale * scale;
+            Uint32 seed = 0;
+            auto setup = [&] {
+                resetHeadlessGame(scale, 0);
+                if (grid) {
+                    bitboardLevel = false;
+                    createBlockLevel();
+                }
+                seed = 12345;
+            };
+            results.push_back(runBench(grid ? "collision.blockGrid" : "collision.bitboard", blocks, 20000, setup, [&](int) {
+                seed = seed * 1664525u + 1013904223u;
+                SDL_Rect area = {static_cast<int>((seed >> 8) % (worldWidth - BALL_SIZE)),
+                                 static_cast<int>((seed >> 4) % (BLOCK_ROWS * BLOCK_HEIGHT * scale)), BALL_SIZE, BALL_SIZE};
+                hitBlock(area);
+            }));
+        }
+    }
+
+    results.push_back(runBench("handleInput", 1, 100000, [&] { resetHeadlessGame(1, 1); },
+                               [&](int) { handleInput(dT); }));
+
+    SDL_Window* window = SDL_CreateWindow("bench", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : nullptr;
+    if (!renderer || !loadSpriteAtlas(renderer, spriteAtlas)) {
+        std::cerr << "Error creating software renderer: " << SDL_GetError() << std::endl;
+    } else {
+        // Solo grabar la cola, y grabarla mas enviarla a SDL y presentar
+        for (int scale : scales) {
+            int blocks = BLOCK_COLUMNS * BLOCK_ROWS * scale * scale;
+            auto record = [&] {
+                resetFrameArena(frameArena);
+                beginRenderQueue(renderQueue, frameArena);
+                renderBlocks(renderQueue);
+            };
+            results.push_back(runBench("renderBlocks", blocks, 200, [&] { resetHeadlessGame(scale, 0); }, [&](int) { record(); }));
+            results.push_back(runBench("renderBlocks.software", blocks, 50, [&] { resetHeadlessGame(scale, 0); }, [&](int) {
+                record();
+                SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+                SDL_RenderClear(renderer);
+                flushRenderQueue(renderQueue, renderer);
+                SDL_RenderPresent(renderer);
+            }));
+        }
+        destroySpriteAtlas(spriteAtlas);
+    }
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    if (window) {
+        SDL_DestroyWindow(window);
+    }
+    unloadLevel(currentLevel);
+
+    if (!writeBenchJson(jsonPath, results)) {
+        return false;
+    }
+    std::cout << "Results written to " << jsonPath << std::endl;
+    return true;
+}
+
+// Archivo completo en memoria, para armar el paquete del benchmark
+static bool readWholeFile(const char* path, std::vector<unsigned char>& data) {
+    MappedFile file;
+    if (!mapFile(file, path, false)) {
+        return false;
+    }
+    data.assign(file.data, file.data + file.size);
+    unmapFile(file);
+    return true;
+}
+
+// Tormenta de particulas sostenida sin ventana (--bench-particles): cada
+// frame repone las que mueren, actualiza y dibuja todo en un renderer por
+// software de SDL sobre una superficie, y tambien con el backend de CPU.
+// El objetivo es 100k vivas dentro de los 16.6 ms de un frame a 60 FPS.
+void benchmarkParticles(int threads) {
+    const int counts[] = {25000, 50000, 100000};
+    const int frames = 120;
+    const float budgetMs = 1000.0f / MAX_FPS;
+    const float dT = 1.0f / MAX_FPS;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* software = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!software) {
+        std::cerr << "Error creating software renderer: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(surface);
+        return;
+    }
+    FrameArena arena;
+    RenderQueue queue;
+    initFrameArena(arena, RENDER_ARENA_SIZE);
+    Camera view;
+    view.viewWidth = SCREEN_WIDTH;
+    view.viewHeight = SCREEN_HEIGHT;
+    view.x = SCREEN_WIDTH / 2.0f;
+    view.y = SCREEN_HEIGHT / 2.0f;
+    CpuRenderer cpu;
+    bool cpuReady = initCpuRenderer(cpu, software, SCREEN_WIDTH, SCREEN_HEIGHT, threads);
+
+    std::printf("backend,particles,update_ms,render_ms,frame_ms,max_frame_ms,budget_ms,fits,dropped\n");
+    for (int backend = 0; backend < 2; ++backend) {
+        if (backend == 1 && !cpuReady) {
+            break;
+        }
+        for (int count : counts) {
+            ParticlePool pool;
+            initParticles(pool, MAX_PARTICLES);
+            Uint32 seed = 12345;
+            double updateMs = 0.0, renderMs = 0.0;
+            float maxFrameMs = 0.0f;
+            long long dropped = 0; // Rectangulos que el backend de CPU no dibujo
+            for (int f = 0; f < frames; ++f) {
+                Uint64 start = SDL_GetPerformanceCounter();
+                // Se reponen las muertas: el costo de crear tambien entra
+                while (pool.count < count) {
+                    seed = seed * 1664525u + 1013904223u;
+                    float x = static_cast<float>((seed >> 8) % SCREEN_WIDTH);
+                    float y = static_cast<float>((seed >> 20) % SCREEN_HEIGHT);
+                    float vx = static_cast<float>(static_cast<int>(seed % 200) - 100);
+                    spawnParticle(pool, x, y, vx, -vx, 0.5f + (seed >> 28) / 10.0f, {0xFF, 0xA0, 0x20, 0xFF});
+                }
+                updateParticles(pool, dT);
+                Uint64 renderStart = SDL_GetPerformanceCounter();
+                resetFrameArena(arena);
+                beginRenderQueue(queue, arena);
+                renderParticles(queue, pool, view);
+                SDL_SetRenderDrawColor(software, 0x00, 0x00, 0x00, 0xFF);
+                SDL_RenderClear(software);
+                if (backend == 0) {
+                    flushRenderQueue(queue, software);
+                } else {
+                    cpuClear(cpu, {0x00, 0x00, 0x00, 0xFF});
+                    flushRenderQueueCpu(queue, cpu, software);
+                    dropped += cpu.dropped;
+                }
+                SDL_RenderPresent(software);
+                Uint64 end = SDL_GetPerformanceCounter();
+                float frameMs = (end - start) * 1000.0f / SDL_GetPerformanceFrequency();
+                updateMs += (renderStart - start) * 1000.0 / SDL_GetPerformanceFrequency();
+                renderMs += (end - renderStart) * 1000.0 / SDL_GetPerformanceFrequency();
+                maxFrameMs = std::max(maxFrameMs, frameMs);
+            }
+            double frameMs = (updateMs + renderMs) / frames;
+            // Con rectangulos descartados el tiempo no cuenta: no se dibujo todo
+            bool fits = frameMs <= budgetMs && dropped == 0;
+            std::printf("%s,%d,%.3f,%.3f,%.3f,%.3f,%.1f,%s,%lld\n", backend == 0 ? "sdl-software" : "cpu", count, updateMs / frames,
+                        renderMs / frames, frameMs, maxFrameMs, budgetMs, fits ? "yes" : "no", dropped);
+        }
+    }
+
+    destroyCpuRenderer(cpu);
+    SDL_DestroyRenderer(software);
+    SDL_FreeSurface(surface);
+}
+
+// Arranque con archivos sueltos contra el paquete: niveles y sprites
+// sinteticos cargados como al iniciar el juego, en frio (fuera de la cache
+// de paginas) y en caliente. El paquete sin comprimir separa lo que cuesta
+// descomprimir de lo que se ahorra en llamadas al sistema.
+void benchmarkAssets() {
+    const int levelCount = 16, imageCount = 48, imageSize = 128;
+    const char* packPath = "bench_assets.pak";
+    const char* rawPackPath = "bench_assets_raw.pak";
+    std::vector<std::string> levels, images;
+    std::vector<PackInput> inputs;
+    long long looseBytes = 0;
+    bool ok = true;
+
+    for (int i = 0; ok && i < levelCount; ++i) {
+        int columns = BLOCK_COLUMNS * 4, rows = BLOCK_ROWS * (2 + i);
+        std::vector<Block> blocks;
+        std::vector<BlockAttributes> attributes;
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                blocks.push_back({{c * BLOCK_WIDTH, r * BLOCK_HEIGHT, BLOCK_WIDTH, BLOCK_HEIGHT}});
+                attributes.push_back(packBlockAttributes(1 + (r + c) % 3, (r * 7 + c) % 10 == 0 ? BLOCK_EXPLOSIVE : BLOCK_NORMAL, (r / 2) % 4));
+            }
+        }
+        const SDL_Color palette[] = {BLOCK_COLOR, {0x20, 0xA0, 0xFF, 0xFF}, {0xFF, 0xD0, 0x40, 0xFF}, {0xFF, 0x40, 0x20, 0xFF}};
+        char name[64];
+        std::snprintf(name, sizeof(name), "bench_asset_level_%02d.lvl", i);
+        levels.push_back(name);
+        ok = writeLevel(name, blocks.data(), attributes.data(), static_cast<int>(blocks.size()), palette, 4,
+                        columns * BLOCK_WIDTH, rows * BLOCK_HEIGHT * 4);
+    }
+    for (int i = 0; ok && i < imageCount; ++i) {
+        SDL_Surface* image = SDL_CreateRGBSurfaceWithFormat(0, imageSize, imageSize, 32, SDL_PIXELFORMAT_ARGB8888);
+        ok = image != nullptr;
+        for (int y = 0; ok && y < imageSize; ++y) {
+            Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(image->pixels) + y * image->pitch);
+            for (int x = 0; x < imageSize; ++x) {
+                int v = (x * 2 + y + i * 16) & 0xFF;
+                row[x] = 0xFF000000u | (v << 16) | ((x ^ y) & 0xF0) << 8 | (((x / 8 + y / 8) & 1) ? 0x40 : 0xC0);
+            }
+        }
+        char name[64];
+        std::snprintf(name, sizeof(name), "bench_asset_image_%02d.bmp", i);
+        images.push_back(name);
+        ok = ok && SDL_SaveBMP(image, name) == 0;
+        SDL_FreeSurface(image);
+    }
+    // Los niveles van sin comprimir para usarlos en el lugar, como en pack_builder
+    for (int k = 0; ok && k < levelCount + imageCount; ++k) {
+        PackInput input;
+        input.name = k < levelCount ? levels[k] : images[k - levelCount];
+        input.compress = k >= levelCount;
+        ok = readWholeFile(input.name.c_str(), input.data);
+        looseBytes += static_cast<long long>(input.data.size());
+        inputs.push_back(std::move(input));
+    }
+    ok = ok && writeAssetPack(packPath, inputs);
+    for (PackInput& input : inputs) {
+        input.compress = false;
+    }
+    ok = ok && writeAssetPack(rawPackPath, inputs);
+    inputs.clear();
+
+    if (ok) {
+        MappedFile packFile;
+        mapFile(packFile, packPath, false);
+        std::cout << levelCount + imageCount << " assets, loose " << looseBytes / 1024 << " kB, pack " << packFile.size / 1024 << " kB" << std::endl;
+        unmapFile(packFile);
+
+        // Se recorren los bloques como lo haria el primer frame
+        volatile int sink = 0;
+        auto touchLevel = [&](const Level& level) {
+            int sum = 0;
+            for (int b = 0; b < level.count; ++b) {
+                sum += level.blocks[b].rect.x;
+            }
+            sink = sink + sum;
+        };
+        auto loadLoose = [&](int) {
+            for (const std::string& name : levels) {
+                Level level;
+                if (loadLevel(level, name.c_str())) {
+                    touchLevel(level);
+                }
+                unloadLevel(level);
+            }
+            for (const std::string& name : images) {
+                SDL_FreeSurface(SDL_LoadBMP(name.c_str()));
+            }
+        };
+        std::vector<unsigned char> scratch;
+        auto loadPacked = [&](const char* path) {
+            AssetPack pack;
+            if (!openAssetPack(pack, path)) {
+                return;
+            }
+            for (const std::string& name : levels) {
+                Level level;
+                if (loadLevel(level, pack, name.c_str())) {
+                    touchLevel(level);
+                }
+                unloadLevel(level);
+            }
+            for (const std::string& name : images) {
+                const PackEntry* entry = findAsset(pack, name.c_str());
+                const unsigned char* data = entry ? assetData(pack, *entry, scratch) : nullptr;
+                if (data) {
+                    SDL_FreeSurface(SDL_LoadBMP_RW(SDL_RWFromConstMem(data, static_cast<int>(entry->size)), 1));
+                }
+            }
+            closeAssetPack(pack);
+        };
+        auto dropLoose = [&] {
+            for (const std::string& name : levels) {
+                dropFileCache(name.c_str());
+            }
+            for (const std::string& name : images) {
+                dropFileCache(name.c_str());
+            }
+        };
+
+        int files = levelCount + imageCount;
+        printBenchHeader();
+        if (dropFileCache(packPath)) {
+            runBench("assets.loose.cold", files, 1, dropLoose, loadLoose);
+            runBench("assets.pack.cold", files, 1, [&] { dropFileCache(packPath); }, [&](int) { loadPacked(packPath); });
+            runBench("assets.packRaw.cold", files, 1, [&] { dropFileCache(rawPackPath); }, [&](int) { loadPacked(rawPackPath); });
+        } else {
+            std::cout << "Cold start not measured: this system can't drop files from the page cache" << std::endl;
+        }
+        runBench("assets.loose.warm", files, 1, [] {}, loadLoose);
+        runBench("assets.pack.warm", files, 1, [] {}, [&](int) { loadPacked(packPath); });
+        runBench("assets.packRaw.warm", files, 1, [] {}, [&](int) { loadPacked(rawPackPath); });
+    } else {
+        std::cerr << "Error creating the benchmark assets" << std::endl;
+    }
+
+    for (const std::string& name : levels) {
+        std::remove(name.c_str());
+    }
+    for (const std::string& name : images) {
+        std::remove(name.c_str());
+    }
+    std::remove(packPath);
+    std::remove(rawPackPath);
+}
+
+int main(int argc, char* argv[]) {
+    beginStartup(startup);
+    bool benchSprites = false;
+    bool benchRenderer = false;
+    bool benchCulling = false;
+    bool benchEndless = false;
+    bool benchBitboard = false;
+    bool benchChain = false;
+    bool benchEntities = false;
+    bool benchLogger = false;
+    bool benchAudio = false;
+    bool benchParticles = false;
+    bool benchAssets = false;
+    bool benchStreaming = false;
+    bool syncAssets = false;
+    bool startupReport = false;
+    float startupBudgetMs = FIRST_FRAME_BUDGET_MS;
+    bool noAudio = false;
+    const char* benchSuitePath = nullptr;
+    bool stress = false;
+    const char* stressBaseline = nullptr;
+    double stressThreshold = STRESS_DEFAULT_THRESHOLD;
+    const char* logPath = nullptr;
+    int profileFrames = 0;
+    const char* telemetryName = nullptr;
+    const char* levelPath = nullptr;
+    const char* packPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-sprites") == 0) {
+            benchSprites = true;
+        } else if (std::strcmp(argv[i], "--bench-renderer") == 0) {
+            benchRenderer = true;
+        } else if (std::strcmp(argv[i], "--renderer=cpu") == 0) {
+            cpuBackend = true;
+        } else if (std::strcmp(argv[i], "--dirty-rects") == 0) {
+            dirtyRectMode = true;
+        } else if (std::strcmp(argv[i], "--bench-culling") == 0) {
+            benchCulling = true;
+        } else if (std::strcmp(argv[i], "--bench-bitboard") == 0) {
+            benchBitboard = true;
+        } else if (std::strcmp(argv[i], "--bench-chain") == 0) {
+            benchChain = true;
+        } else if (std::strcmp(argv[i], "--bench-entities") == 0) {
+            benchEntities = true;
+        } else if (std::strcmp(argv[i], "--bench-logger") == 0) {
+            benchLogger = true;
+        } else if (std::strcmp(argv[i], "--bench-audio") == 0) {
+            benchAudio = true;
+        } else if (std::strcmp(argv[i], "--bench-particles") == 0) {
+            benchParticles = true;
+        } else if (std::strcmp(argv[i], "--bench-assets") == 0) {
+            benchAssets = true;
+        } else if (std::strcmp(argv[i], "--bench-streaming") == 0) {
+            benchStreaming = true;
+        } else if (std::strcmp(argv[i], "--sync-assets") == 0) {
+            syncAssets = true;
+        } else if (std::strcmp(argv[i], "--startup-report") == 0) {
+            startupReport = true;
+        } else if (std::strncmp(argv[i], "--startup-budget=", 17) == 0) {
+            startupBudgetMs = static_cast<float>(std::atof(argv[i] + 17));
+        } else if (std::strncmp(argv[i], "--pack=", 7) == 0) {
+            packPath = argv[i] + 7;
+        } else if (std::strcmp(argv[i], "--no-audio") == 0) {
+            noAudio = true;
+        } else if (std::strcmp(argv[i], "--bench-suite") == 0) {
+            benchSuitePath = "bench.json";
+        } else if (std::strncmp(argv[i], "--bench-suite=", 14) == 0) {
+            benchSuitePath = argv[i] + 14;
+        } else if (std::strcmp(argv[i], "--stress") == 0) {
+            stress = true;
+        } else if (std::strncmp(argv[i], "--stress-baseline=", 18) == 0) {
+            stress = true;
+            stressBaseline = argv[i] + 18;
+        } else if (std::strncmp(argv[i], "--stress-threshold=", 19) == 0) {
+            stressThreshold = std::atof(argv[i] + 19);
+        } else if (std::strncmp(argv[i], "--log=", 6) == 0) {
+            logPath = argv[i] + 6;
+        } else if (std::strncmp(argv[i], "--profile=", 10) == 0) {
+            profileFrames = std::atoi(argv[i] + 10);
+        } else if (std::strcmp(argv[i], "--telemetry") == 0) {
+            telemetryName = TELEMETRY_DEFAULT_NAME;
+        } else if (std::strncmp(argv[i], "--telemetry=", 12) == 0) {
+            telemetryName = argv[i] + 12;
+        } else if (std::strcmp(argv[i], "--endless") == 0) {
+            endlessMode = true;
+        } else if (std::strcmp(argv[i], "--bench-endless") == 0) {
+            benchEndless = true;
+            endlessMode = true;
+        } else if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            endlessSeed = static_cast<Uint32>(std::strtoul(argv[i] + 7, nullptr, 10));
+        } else if (std::strncmp(argv[i], "--level=", 8) == 0) {
+            levelPlaylist.push_back(argv[i] + 8);
+            levelPath = levelPlaylist[0];
+        } else if (std::strncmp(argv[i], "--arena=", 8) == 0) {
+            arenaScale = std::atoi(argv[i] + 8);
+        } else if (std::strcmp(argv[i], "--strict-allocations") == 0) {
+            strictAllocations = true;
+        } else if (std::strncmp(argv[i], "--frame-budget=", 15) == 0) {
+            scaler.budgetMs = static_cast<float>(std::atof(argv[i] + 15));
+        }
+    }
+    int renderThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    Uint64 phase = SDL_GetPerformanceCounter();
     SDL_SetMainReady(); // Esto se llama para inicializar correctamente SDL en entornos no predeterminados
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
+    if (benchSuitePath || stress) {
+        // Sin ventana real: mismos resultados en una maquina sin pantalla
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    }
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         std::cerr << "Error initializing SDL: " << SDL_GetError() << std::endl;
         return -1;
     }
+    recordStartupPhase(startup, "SDL_Init", phase);
+
+    if (benchSuitePath) {
+        bool written = benchmarkSuite(benchSuitePath);
+        SDL_Quit();
+        return written ? 0 : -1;
+    }
+    if (stress) {
+        int code = runStressScenarios(stressBaseline, stressThreshold);
+        SDL_Quit();
+        return code;
+    }
+
+    if (benchRenderer) {
+        benchmarkRenderers(renderThreads);
+        SDL_Quit();
+        return 0;
+    }
+    if (benchChain) {
+        benchmarkChain();
+        SDL_Quit();
+        return 0;
+    }
+    if (benchLogger) {
+        benchmarkLogger(10000000);
+        SDL_Quit();
+        return 0;
+    }
+    if (benchParticles) {
+        benchmarkParticles(renderThreads);
+        SDL_Quit();
+        return 0;
+    }
+    if (benchAudio) {
+        benchmarkAudio();
+        SDL_Quit();
+        return 0;
+    }
+    if (benchAssets) {
+        benchmarkAssets();
+        SDL_Quit();
+        return 0;
+    }
+    if (benchEntities) {
+        benchmarkEntities();
+        SDL_Quit();
+        return 0;
+    }
+    if (benchBitboard) {
+        benchmarkBitboard(1000000, 600);
+        SDL_Quit();
+        return 0;
+    }
+    if (benchEndless) {
+        benchmarkEndless();
+        SDL_Quit();
+        return 0;
+    }
+
+    phase = SDL_GetPerformanceCounter();
+    if (packPath && !openAssetPack(assetPack, packPath)) {
+        SDL_Quit();
+        return -1;
+    }
+    recordStartupPhase(startup, "asset pack", phase);
+
+    // El nivel define el tamano del mundo, pero nada lo usa hasta despues de
+    // crear la ventana y el renderer: se carga en paralelo. El mismo hilo
+    // llena la arena de render y el pool de particulas (~50 MB entre los
+    // dos), que es lo mas pesado del resto.
+    bool levelLoaded = true;
+    std::thread loader([&] {
+        if (levelPath && !endlessMode) {
+            Uint64 start = SDL_GetPerformanceCounter();
+            levelLoaded = findAsset(assetPack, levelPath) ? loadLevel(currentLevel, assetPack, levelPath) : loadLevel(currentLevel, levelPath);
+            recordStartupPhase(startup, "level load", start, true);
+        }
+        Uint64 start = SDL_GetPerformanceCounter();
+        initFrameArena(frameArena, RENDER_ARENA_SIZE);
+        initParticles(particles, MAX_PARTICLES);
+        recordStartupPhase(startup, "arena and particles", start, true);
+    });
+    // Espera al hilo de carga y arma el mundo; false si el nivel no cargo
+    auto finishLoading = [&] {
+        if (!loader.joinable()) {
+            return levelLoaded;
+        }
+        Uint64 start = SDL_GetPerformanceCounter();
+        loader.join();
+        recordStartupPhase(startup, "wait for loader", start);
+        if (!levelLoaded) {
+            return false;
+        }
+        if (levelPath && !endlessMode) {
+            std::cout << "Level " << levelPath << ": " << currentLevel.count << " blocks, grid " << (currentLevel.gridFromFile ? "mapped" : "built")
+                      << ", loaded in " << currentLevel.loadMs << " ms" << std::endl;
+            blocksAlive = currentLevel.breakable;
+            setupWorld(currentLevel.worldWidth, currentLevel.worldHeight);
+        } else {
+            setupWorld(SCREEN_WIDTH * arenaScale, SCREEN_HEIGHT * arenaScale);
+        }
+        return true;
+    };
+
+    if (benchCulling) {
+        bool loaded = finishLoading();
+        if (loaded) {
+            benchmarkCulling();
+        }
+        unloadLevel(currentLevel);
+        closeAssetPack(assetPack);
+        SDL_Quit();
+        return loaded ? 0 : -1;
+    }
+
+    if (dirtyRectMode && cpuBackend) {
+        std::cerr << "--dirty-rects is ignored with --renderer=cpu" << std::endl;
+        dirtyRectMode = false;
+    }
 
-    SDL_Window* window = SDL_CreateWindow("Bouncing Ball with Paddle", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+    // La superficie de la ventana del modo de rectangulos sucios no se puede redimensionar
+    Uint32 windowFlags = dirtyRectMode ? SDL_WINDOW_SHOWN : SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE;
+    phase = SDL_GetPerformanceCounter();
+    SDL_Window* window = SDL_CreateWindow("Bouncing Ball with Paddle", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, windowFlags);
     if (!window) {
         std::cerr << "Error creating window: " << SDL_GetError() << std::endl;
+        loader.join();
         SDL_Quit();
         return -1;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    // El benchmark de sprites se mide siempre con el renderer por software,
+    // y con el backend de CPU SDL solo copia el framebuffer a la ventana
+    recordStartupPhase(startup, "window", phase);
+    Uint32 rendererFlags = (benchSprites || cpuBackend) ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+    // En modo de rectangulos sucios se dibuja directo en la superficie de la
+    // ventana para poder presentar solo las regiones que cambiaron
+    phase = SDL_GetPerformanceCounter();
+    SDL_Renderer* renderer = dirtyRectMode ? SDL_CreateSoftwareRenderer(SDL_GetWindowSurface(window))
+                                           : SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         std::cerr << "Error creating renderer: " << SDL_GetError() << std::endl;
+        loader.join();
         SDL_DestroyWindow(window);
         SDL_Quit();
         return -1;
     }
+    recordStartupPhase(startup, "renderer", phase);
 
-    createBlocks();
+    if (benchStreaming) {
+        loader.join();
+        benchmarkStreaming(renderer);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 0;
+    }
+
+    // Sin --sync-assets el atlas arranca con el arte generado y las imagenes
+    // llegan despues por el streamer
+    phase = SDL_GetPerformanceCounter();
+    if (!loadSpriteAtlas(renderer, spriteAtlas, &assetPack, !syncAssets && !benchSprites)) {
+        std::cerr << "Error creating sprite atlas: " << SDL_GetError() << std::endl;
+        loader.join();
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return -1;
+    }
+
+    recordStartupPhase(startup, "sprite atlas", phase);
+
+    if (benchSprites) {
+        loader.join();
+        benchmarkSprites(renderer, spriteAtlas, SCREEN_WIDTH, SCREEN_HEIGHT);
+        destroySpriteAtlas(spriteAtlas);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 0;
+    }
+
+    phase = SDL_GetPerformanceCounter();
+    if (cpuBackend && !initCpuRenderer(cpuRenderer, renderer, SCREEN_WIDTH, SCREEN_HEIGHT, renderThreads)) {
+        std::cerr << "Error creating CPU renderer: " << SDL_GetError() << std::endl;
+        loader.join();
+        destroyCpuRenderer(cpuRenderer);
+        destroySpriteAtlas(spriteAtlas);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return -1;
+    }
+
+    if (!cpuBackend && !dirtyRectMode) {
+        scaledRendering = initResolutionScaler(scaler, renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    recordStartupPhase(startup, cpuBackend ? "cpu renderer" : "render targets", phase);
+
+    if (!finishLoading()) {
+        destroyResolutionScaler(scaler);
+        destroyCpuRenderer(cpuRenderer);
+        destroySpriteAtlas(spriteAtlas);
+        closeAssetPack(assetPack);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return -1;
+    }
+
+    phase = SDL_GetPerformanceCounter();
+    if (endlessMode) {
+        initEndless(endless, endlessSeed, BLOCK_COLUMNS * arenaScale, BLOCK_WIDTH, BLOCK_HEIGHT, worldHeight, BLOCK_ROWS * BLOCK_HEIGHT * arenaScale);
+        endless.speed = ENDLESS_SCROLL_SPEED * arenaScale;
+    } else if (!levelPath) {
+        createBlocks();
+    }
+    initEntityWorld(entityWorld, MAX_ENTITIES);
+    reserveEntities(entityWorld, PADDLE_COMPONENTS, 1);
+    reserveEntities(entityWorld, BALL_COMPONENTS, MAX_BALLS);
+    reserveEntities(entityWorld, POWERUP_COMPONENTS, MAX_POWERUPS);
+    reserveEntities(entityWorld, LASER_COMPONENTS, MAX_LASER_SHOTS);
+    createPaddle();
+    spawnBall(BALL_START);
+    flushEntityCommands(entityWorld);
+    recordStartupPhase(startup, "world", phase);
+    phase = SDL_GetPerformanceCounter();
+    if (!createHud(renderer)) {
+        std::cerr << "Error creating glyph atlas: " << SDL_GetError() << std::endl;
+        destroyGlyphAtlas(glyphAtlas);
+        destroyEndless(endless);
+        destroyResolutionScaler(scaler);
+        destroyCpuRenderer(cpuRenderer);
+        destroySpriteAtlas(spriteAtlas);
+        unloadLevel(currentLevel);
+        closeAssetPack(assetPack);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return -1;
+    }
+    recordStartupPhase(startup, "hud", phase);
+
+    // Eventos del juego: el hilo principal escribe en su anillo y otro hilo
+    // los pasa a --log=archivo, o a stdout si no se pudo abrir
+    phase = SDL_GetPerformanceCounter();
+    if (!startLogger(logPath)) {
+        startLogger(nullptr);
+    }
+    registerLogThread("main");
+
+    // --profile=N captura los primeros N frames; F9 captura en cualquier momento
+    registerProfileThread("main");
+#ifdef GAME_PROFILER
+    requestProfileCapture(profileFrames);
+#else
+    if (profileFrames > 0) {
+        std::cerr << "Profiler not compiled in, rebuild with -DGAME_PROFILER=ON" << std::endl;
+    }
+#endif
+
+    recordStartupPhase(startup, "logger", phase);
+
+    // Arte y nivel siguiente en segundo plano: el primer frame no los espera
+    phase = SDL_GetPerformanceCounter();
+    initAssetStreamer(streamer, renderer, &assetPack);
+    if (syncAssets) {
+        std::fill(spriteArt, spriteArt + SPRITE_COUNT, INVALID_HANDLE);
+    } else {
+        streamSpriteArt(streamer, spriteAtlas, spriteArt);
+    }
+    if (!endlessMode) {
+        requestNextLevel();
+    }
+    recordStartupPhase(startup, "streamer", phase);
+
+    // Sin el bloque compartido el juego sigue; solo no se puede monitorear
+    if (telemetryName) {
+        phase = SDL_GetPerformanceCounter();
+        createTelemetry(telemetry, telemetryName);
+        recordStartupPhase(startup, "telemetry", phase);
+    }
+
+    // Sin dispositivo de audio el juego sigue en silencio. Abrirlo puede
+    // tardar mas que todo lo anterior, asi que no se espera: los sonidos de
+    // los primeros frames se pierden hasta que esta listo.
+    std::thread audioStarter;
+    if (!noAudio) {
+        audioStarter = std::thread([] {
+            // Puede terminar despues del calentamiento; no cuenta como reserva del frame
+            ignoreThreadAllocations();
+            Uint64 start = SDL_GetPerformanceCounter();
+            startAudio();
+            recordStartupPhase(startup, "audio", start, true);
+        });
+    }
 
     bool quit = false;
+    int exitCode = 0;
+    int frameNumber = 0;
+    Uint64 ticks = 0, ticksAtLastUpdate = 0;
     bool gameOver = false;
     bool youWin = false;
     SDL_Event e;
@@ -172,9 +1869,14 @@ int main() {
     Uint32 frameStartTimestamp, frameEndTimestamp, lastFrameTime = SDL_GetTicks(), lastUpdateTime = 0;
     float frameDuration = (1.0f / MAX_FPS) * 1000.0f;
     int FPS = MAX_FPS;
+    Uint64 loopStart = SDL_GetPerformanceCounter();
 
     while (!quit) {
+        // Exporta la traza al cerrar la ultima captura, antes de abrir el frame
+        profileFrame();
+        PROFILE_ZONE("frame");
         frameStartTimestamp = SDL_GetTicks();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
 
         // delta time
         Uint32 currentFrameTime = SDL_GetTicks();
@@ -186,32 +1888,170 @@ int main() {
             if (e.type == SDL_QUIT) {
                 quit = true;
             }
+            if (e.type == SDL_WINDOWEVENT) {
+                markFullDirty(dirty);
+                if (scaledRendering && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                    scaledRendering = resizeResolutionScaler(scaler, renderer);
+                }
+            }
+            // Tormenta de particulas para medir el pool a plena carga
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_p) {
+                SDL_Rect area = cameraView(camera);
+                area.h /= 2;
+                spawnBlockDebris(particles, area, {0xFF, 0xA0, 0x20, 0xFF}, PARTICLE_STORM);
+            }
+            // Zoom de la camara
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_EQUALS) {
+                camera.zoom = std::min(MAX_CAMERA_ZOOM, camera.zoom * 1.25f);
+            }
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_MINUS) {
+                camera.zoom = std::max(MIN_CAMERA_ZOOM, camera.zoom / 1.25f);
+            }
+            // Captura del perfilador de los proximos frames
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F9) {
+                requestProfileCapture(PROFILE_HOTKEY_FRAMES);
+            }
         }
 
+        // Reservas en el heap por fase: entrada, simulacion y render
+        long long allocationMark = heapAllocationCount();
+        long long allocationBytes = heapAllocationBytes();
+
         // handle input
         if (!gameOver && !youWin) {
             handleInput(dT);
         }
+        stats.inputAllocations = allocationsSince(allocationMark);
 
         // update
         if (!gameOver && !youWin) {
             update(dT, gameOver, youWin);
+            ticks++;
+        }
+
+        // pared del modo sin fin
+        if (endlessMode && !gameOver) {
+            int previousScroll = static_cast<int>(endless.scroll);
+            updateEndless(endless, dT);
+            if (static_cast<int>(endless.scroll) != previousScroll) {
+                markFullDirty(dirty);
+            }
+            stats.chunksActive = static_cast<int>(endless.active.size());
+            stats.chunkGenerationMs = endless.generationMs;
+            stats.chunkStalls = endless.stalls;
+        }
+
+        // Sube lo que termino de cargar; al ganar se pasa al nivel siguiente
+        // en cuanto esta listo
+        pumpAssetStreamer(streamer, STREAM_UPLOAD_BUDGET_MS);
+        if (youWin && nextLevelHandle != INVALID_HANDLE && switchToNextLevel()) {
+            youWin = false;
         }
 
-        // render
-        SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
-        SDL_RenderClear(renderer);
+        // particulas
+        Uint64 particleStart = SDL_GetPerformanceCounter();
+        updateParticles(particles, dT);
+        stats.particleUpdateMs = (SDL_GetPerformanceCounter() - particleStart) * 1000.0f / SDL_GetPerformanceFrequency();
 
-        renderRect(renderer, ball);
-        renderPaddle(renderer, paddle);
-        renderBlocks(renderer);
+        // camara
+        Camera previousCamera = camera;
+        Rect followed;
+        if (firstBall(followed)) {
+            followCamera(camera, followed.rect.x + followed.rect.w / 2.0f, followed.rect.y + followed.rect.h / 2.0f, worldWidth, worldHeight, dT);
+        }
+        if (camera.x != previousCamera.x || camera.y != previousCamera.y || camera.zoom != previousCamera.zoom) {
+            markFullDirty(dirty);
+        }
+
+        stats.updateAllocations = allocationsSince(allocationMark);
+
+        // render: se graba todo en la cola y se envia ordenado por estado
+        Uint64 renderStart = SDL_GetPerformanceCounter();
+        resetFrameArena(frameArena);
+        beginRenderQueue(renderQueue, frameArena);
+
+        renderEntities(renderQueue);
+        renderBlocks(renderQueue);
+        renderParticles(renderQueue, particles, camera);
+        updateHud(gameOver, youWin);
+        renderText(renderQueue, glyphAtlas, hud);
+
+        if (dirtyRectMode) {
+            // Borrar y redibujar solo las regiones sucias
+            trackDirtyRegions();
+            mergeDirtyRects(dirty, SCREEN_WIDTH, SCREEN_HEIGHT);
+            for (int i = 0; i < dirty.count; ++i) {
+                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+                SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+                SDL_RenderFillRect(renderer, &dirty.rects[i]);
+                flushRenderQueueClipped(renderQueue, renderer, dirty.rects[i]);
+            }
+            stats.dirtyRects = dirty.count;
+            stats.pixelsTouched = dirty.pixels;
+        } else {
+            if (cpuBackend) {
+                SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+                SDL_RenderClear(renderer);
+                cpuClear(cpuRenderer, {0x00, 0x00, 0x00, 0xFF});
+                flushRenderQueueCpu(renderQueue, cpuRenderer, renderer);
+                stats.cpuRectsDropped += cpuRenderer.dropped;
+            } else if (scaledRendering) {
+                beginScaledFrame(scaler, renderer);
+                flushRenderQueue(renderQueue, renderer);
+                endScaledFrame(scaler, renderer);
+            } else {
+                SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+                SDL_RenderClear(renderer);
+                flushRenderQueue(renderQueue, renderer);
+            }
+            stats.dirtyRects = 1;
+            stats.pixelsTouched = SCREEN_WIDTH * SCREEN_HEIGHT;
+        }
+        stats.drawCalls = renderQueue.drawCalls;
+        stats.stateChanges = renderQueue.stateChanges;
+        stats.renderCommands = renderQueue.count;
+
+        if (dirtyRectMode) {
+            SDL_RenderFlush(renderer);
+            if (dirty.count > 0) {
+                SDL_UpdateWindowSurfaceRects(window, dirty.rects, dirty.count);
+            }
+            clearDirtyRects(dirty);
+        } else {
+            PROFILE_ZONE("present");
+            SDL_RenderPresent(renderer);
+        }
 
-        SDL_RenderPresent(renderer);
+        stats.renderMs = (SDL_GetPerformanceCounter() - renderStart) * 1000.0f / SDL_GetPerformanceFrequency();
+        if (scaledRendering) {
+            updateResolutionScaler(scaler, stats.renderMs);
+        }
+        stats.renderAllocations = allocationsSince(allocationMark);
+        stats.frameAllocations = stats.inputAllocations + stats.updateAllocations + stats.renderAllocations;
+        frameNumber++;
+        setLogFrame(frameNumber);
+        if (frameNumber == 1) {
+            recordStartupPhase(startup, "first frame", loopStart);
+            finishStartup(startup, startupBudgetMs, startupReport);
+        }
+        if (strictAllocations && frameNumber > ALLOCATION_WARMUP_FRAMES && stats.frameAllocations > 0) {
+            std::cerr << "Heap allocation after warm-up in frame " << frameNumber << ": input " << stats.inputAllocations
+                      << ", update " << stats.updateAllocations << ", render " << stats.renderAllocations
+                      << " (" << heapAllocationBytes() - allocationBytes << " bytes)" << std::endl;
+            exitCode = 1;
+            quit = true;
+        }
+        stats.resolutionScale = scaler.scale;
+        stats.effectQuality = scaler.effectQuality;
+        stats.frameMs = (SDL_GetPerformanceCounter() - frameStart) * 1000.0f / SDL_GetPerformanceFrequency();
+        stats.frameMsMax = std::max(stats.frameMsMax, stats.frameMs);
+        publishFrameTelemetry(frameNumber, ticks);
 
         frameEndTimestamp = SDL_GetTicks();
         float actualFrameDuration = frameEndTimestamp - frameStartTimestamp;
 
         if (actualFrameDuration < frameDuration) {
+            PROFILE_ZONE("sleep");
             SDL_Delay(frameDuration - actualFrameDuration);
         }
 
@@ -219,14 +2059,74 @@ int main() {
         Uint32 currentTime = SDL_GetTicks();
         if (currentTime - lastUpdateTime > 1000) {
             FPS = static_cast<int>((1.0f / actualFrameDuration) * 1000.0f);
-            SDL_SetWindowTitle(window, ("FPS: " + std::to_string(FPS)).c_str());
+            stats.ticksPerSecond = (ticks - ticksAtLastUpdate) * 1000.0f / (currentTime - lastUpdateTime);
+            ticksAtLastUpdate = ticks;
+            stats.fps = FPS;
+            stats.particlesAlive = particles.count;
+            stats.particleCapacity = particles.capacity;
+            stats.particlesDropped = particles.dropped;
+            // Sin std::string: el titulo se arma en un buffer de la pila
+            char title[512];
+            int length = std::snprintf(title, sizeof(title),
+                                       "FPS: %d | Particles: %d/%d (%f ms) | Cmds: %d Draws: %d States: %d | Pixels: %d (%d rects)"
+                                       " | Scale: %d%% FX: %d | Blocks: %d/%d | Balls: %d PowerUps: %d Shots: %d (%f ms)"
+                                       " | Entities: %d (%d chunks) | Allocs: %d (in %d, up %d, draw %d) | Log drops: %lld",
+                                       stats.fps, stats.particlesAlive, stats.particleCapacity, stats.particleUpdateMs,
+                                       stats.renderCommands, stats.drawCalls, stats.stateChanges, stats.pixelsTouched, stats.dirtyRects,
+                                       static_cast<int>(stats.resolutionScale * 100), stats.effectQuality,
+                                       stats.blocksVisible, endlessMode ? endlessAlive(endless) : blocksAlive,
+                                       stats.balls, stats.powerUps, stats.laserShots, stats.powerUpMs, stats.entities, stats.entityChunks,
+                                       stats.frameAllocations, stats.inputAllocations, stats.updateAllocations, stats.renderAllocations,
+                                       loggerDropped());
+            if (endlessMode && length > 0 && length < static_cast<int>(sizeof(title))) {
+                std::snprintf(title + length, sizeof(title) - length, " | Chunks: %d (%f ms, %d stalls)",
+                              stats.chunksActive, stats.chunkGenerationMs, stats.chunkStalls);
+            }
+            length = static_cast<int>(std::strlen(title));
+            if (stats.cpuRectsDropped > 0 && length < static_cast<int>(sizeof(title))) {
+                std::snprintf(title + length, sizeof(title) - length, " | CPU drops: %d", stats.cpuRectsDropped);
+            }
+            length = static_cast<int>(std::strlen(title));
+            if (audioRunning() && length < static_cast<int>(sizeof(title))) {
+                std::snprintf(title + length, sizeof(title) - length, " | Audio: %d voices, %u us, %u underruns",
+                              audioStats.voices.load(std::memory_order_relaxed), audioStats.lastCallbackUs.load(std::memory_order_relaxed),
+                              audioStats.underruns.load(std::memory_order_relaxed));
+            }
+            length = static_cast<int>(std::strlen(title));
+            if (streamer.stats.requested > 0 && length < static_cast<int>(sizeof(title))) {
+                std::snprintf(title + length, sizeof(title) - length, " | Streaming: %d pending, upload %.2f ms (max %.2f)",
+                              streamer.stats.pending, streamer.stats.uploadMs, streamer.stats.uploadMsMax);
+            }
+            SDL_SetWindowTitle(window, title);
             lastUpdateTime = currentTime;
+            stats.frameMsMax = 0.0f;
         }
     }
 
+    if (streamer.stats.requested > 0) {
+        const StreamStats& streamed = streamer.stats;
+        std::printf("Streaming: %d ready, %d failed, upload %.3f ms avg / %.3f ms max per frame, slowest asset %.1f ms\n",
+                    streamed.ready, streamed.failed, streamed.uploadFrames > 0 ? streamed.uploadMsTotal / streamed.uploadFrames : 0.0,
+                    streamed.uploadMsMax, streamed.readyMsMax);
+    }
+
+    destroyEndless(endless);
+    if (audioStarter.joinable()) {
+        audioStarter.join();
+    }
+    stopAudio();
+    destroyAssetStreamer(streamer);
+    closeTelemetry(telemetry);
+    stopLogger();
+    destroyResolutionScaler(scaler);
+    destroyCpuRenderer(cpuRenderer);
+    destroyGlyphAtlas(glyphAtlas);
+    destroySpriteAtlas(spriteAtlas);
+    unloadLevel(currentLevel);
+    closeAssetPack(assetPack);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
 
-    return 0;
+    return exitCode;
 }
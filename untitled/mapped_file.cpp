@@ -0,0 +1,99 @@
+#include "mapped_file.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+bool mapFile(MappedFile& mapped, const char* path, bool copyOnWrite) {
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    mapped.data = static_cast<unsigned char*>(data);
+    mapped.size = static_cast<size_t>(size.QuadPart);
+    mapped.file = file;
+    mapped.mapping = mapping;
+    return true;
+}
+
+void unmapFile(MappedFile& mapped) {
+    if (mapped.data) {
+        UnmapViewOfFile(mapped.data);
+        CloseHandle(mapped.mapping);
+        CloseHandle(mapped.file);
+    }
+    mapped = MappedFile();
+}
+
+bool dropFileCache(const char*) {
+    return false;
+}
+#else
+bool mapFile(MappedFile& mapped, const char* path, bool copyOnWrite) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    int protection = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), protection, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    mapped.data = static_cast<unsigned char*>(data);
+    mapped.size = static_cast<size_t>(info.st_size);
+    mapped.fd = fd;
+    return true;
+}
+
+void unmapFile(MappedFile& mapped) {
+    if (mapped.data) {
+        munmap(mapped.data, mapped.size);
+        close(mapped.fd);
+    }
+    mapped = MappedFile();
+}
+
+bool dropFileCache(const char* path) {
+#ifdef POSIX_FADV_DONTNEED
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    // Las paginas limpias que nadie tiene mapeadas se descartan
+    bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return dropped;
+#else
+    (void)path;
+    return false;
+#endif
+}
+#endif
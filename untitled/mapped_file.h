@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+
+// Archivo proyectado en memoria. Con `copyOnWrite` las paginas se pueden
+// modificar en memoria sin tocar el archivo (solo se copian las escritas).
+struct MappedFile {
+    unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+bool mapFile(MappedFile& mapped, const char* path, bool copyOnWrite);
+void unmapFile(MappedFile& mapped);
+
+// Saca el archivo de la cache de paginas del sistema para medir una carga
+// en frio. false donde el sistema no lo permite sin privilegios (Windows).
+bool dropFileCache(const char* path);
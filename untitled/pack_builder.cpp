@@ -0,0 +1,99 @@
+// Arma el paquete de assets que el juego carga con --pack=archivo.
+//
+//   pack_builder salida.pak archivo...         los nombres son las rutas tal cual
+//   pack_builder --raw salida.pak archivo...   todo sin comprimir
+//   pack_builder --list paquete.pak            contenido; descomprime todo para verificarlo
+//
+// Los niveles (.lvl) siempre van sin comprimir para usarlos en el lugar
+// desde el mapeo; el resto se comprime si se gana al menos 1/8.
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "asset_pack.h"
+
+static bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+// El juego busca con '/' aunque el paquete se arme en Windows
+static std::string assetName(const char* path) {
+    std::string name = path;
+    std::replace(name.begin(), name.end(), '\\', '/');
+    while (name.compare(0, 2, "./") == 0) {
+        name.erase(0, 2);
+    }
+    return name;
+}
+
+static bool buildPack(const char* output, char** files, int count, bool raw) {
+    std::vector<PackInput> inputs(count);
+    for (int i = 0; i < count; ++i) {
+        std::ifstream in(files[i], std::ios::binary);
+        if (!in) {
+            std::cerr << "Error opening " << files[i] << std::endl;
+            return false;
+        }
+        inputs[i].data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        inputs[i].name = assetName(files[i]);
+        inputs[i].compress = !raw && !endsWith(inputs[i].name, ".lvl");
+    }
+    if (!writeAssetPack(output, inputs)) {
+        return false;
+    }
+    AssetPack pack;
+    if (!openAssetPack(pack, output)) {
+        return false;
+    }
+    Uint64 original = 0;
+    for (const PackInput& input : inputs) {
+        original += input.data.size();
+    }
+    std::cout << output << ": " << count << " assets, " << original / 1024 << " kB -> " << pack.file.size / 1024 << " kB" << std::endl;
+    closeAssetPack(pack);
+    return true;
+}
+
+static bool listPack(const char* path) {
+    AssetPack pack;
+    if (!openAssetPack(pack, path)) {
+        return false;
+    }
+    bool ok = true;
+    std::vector<unsigned char> scratch;
+    for (Uint32 i = 0; i < pack.header->entryCount; ++i) {
+        const PackEntry& e = pack.entries[i];
+        bool compressed = (e.flags & PACK_ENTRY_COMPRESSED) != 0;
+        bool readable = assetData(pack, e, scratch) != nullptr;
+        std::printf("%-40s %10llu %10llu %6.1f%% %-4s %s\n", e.name, static_cast<unsigned long long>(e.size),
+                    static_cast<unsigned long long>(e.storedSize), e.size ? 100.0 * e.storedSize / e.size : 100.0,
+                    compressed ? "lz" : "raw", readable ? "ok" : "CORRUPT");
+        ok = ok && readable;
+    }
+    closeAssetPack(pack);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    bool ok;
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0) {
+        ok = listPack(argv[2]);
+    } else if (argc >= 4 && std::strcmp(argv[1], "--raw") == 0) {
+        ok = buildPack(argv[2], argv + 3, argc - 3, true);
+    } else if (argc >= 3 && argv[1][0] != '-') {
+        ok = buildPack(argv[1], argv + 2, argc - 2, false);
+    } else {
+        std::cerr << "usage: pack_builder output.pak file..." << std::endl;
+        std::cerr << "       pack_builder --raw output.pak file..." << std::endl;
+        std::cerr << "       pack_builder --list input.pak" << std::endl;
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+#include "particles.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PARTICLES_SSE2 1
+#endif
+
+static float randomFloat(Uint32& seed) {
+    // xorshift32, suficiente para efectos visuales
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (seed >> 8) * (1.0f / 16777216.0f);
+}
+
+void initParticles(ParticlePool& pool, int capacity) {
+    pool.capacity = capacity;
+    pool.count = 0;
+    pool.dropped = 0;
+    pool.x.assign(capacity, 0.0f);
+    pool.y.assign(capacity, 0.0f);
+    pool.vx.assign(capacity, 0.0f);
+    pool.vy.assign(capacity, 0.0f);
+    pool.life.assign(capacity, 0.0f);
+    pool.fade.assign(capacity, 0.0f);
+    pool.color.assign(capacity, SDL_Color{0, 0, 0, 0});
+
+    // Los indices de los quads nunca cambian, se generan una sola vez
+    pool.vertices.resize(capacity * 4);
+    pool.indices.resize(capacity * 6);
+    for (int i = 0; i < capacity; ++i) {
+        int v = i * 4;
+        int* idx = &pool.indices[i * 6];
+        idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+    }
+}
+
+void spawnParticle(ParticlePool& pool, float x, float y, float vx, float vy, float life, SDL_Color color) {
+    if (pool.count >= pool.capacity) {
+        pool.dropped++;
+        return;
+    }
+    int i = pool.count++;
+    pool.x[i] = x;
+    pool.y[i] = y;
+    pool.vx[i] = vx;
+    pool.vy[i] = vy;
+    pool.life[i] = life;
+    pool.fade[i] = 1.0f / life;
+    pool.color[i] = color;
+}
+
+void spawnBlockDebris(ParticlePool& pool, const SDL_Rect& rect, SDL_Color color, int amount) {
+    for (int n = 0; n < amount; ++n) {
+        float px = rect.x + randomFloat(pool.seed) * rect.w;
+        float py = rect.y + randomFloat(pool.seed) * rect.h;
+        float vx = (randomFloat(pool.seed) - 0.5f) * 240.0f;
+        float vy = -randomFloat(pool.seed) * 160.0f;
+        float life = 0.6f + randomFloat(pool.seed) * 0.8f;
+        spawnParticle(pool, px, py, vx, vy, life, color);
+    }
+}
+
+void spawnTrail(ParticlePool& pool, const SDL_Rect& rect, SDL_Color color) {
+    float px = rect.x + randomFloat(pool.seed) * rect.w;
+    float py = rect.y + randomFloat(pool.seed) * rect.h;
+    spawnParticle(pool, px, py, 0.0f, -PARTICLE_GRAVITY * 0.1f, 0.25f, color);
+}
+
+void updateParticles(ParticlePool& pool, float dT) {
+    PROFILE_ZONE("particles");
+    float* x = pool.x.data();
+    float* y = pool.y.data();
+    float* vx = pool.vx.data();
+    float* vy = pool.vy.data();
+    float* life = pool.life.data();
+    int n = pool.count;
+    int i = 0;
+
+#ifdef PARTICLES_SSE2
+    // Kernel SIMD: integra 4 particulas por iteracion
+    __m128 dt4 = _mm_set1_ps(dT);
+    __m128 g4 = _mm_set1_ps(PARTICLE_GRAVITY * dT);
+    for (; i + 4 <= n; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pvx = _mm_loadu_ps(vx + i);
+        __m128 pvy = _mm_loadu_ps(vy + i);
+        __m128 pl = _mm_loadu_ps(life + i);
+        _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_mul_ps(pvx, dt4)));
+        _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_mul_ps(pvy, dt4)));
+        _mm_storeu_ps(vy + i, _mm_add_ps(pvy, g4));
+        _mm_storeu_ps(life + i, _mm_sub_ps(pl, dt4));
+    }
+#endif
+    for (; i < n; ++i) {
+        x[i] += vx[i] * dT;
+        y[i] += vy[i] * dT;
+        vy[i] += PARTICLE_GRAVITY * dT;
+        life[i] -= dT;
+    }
+
+    // Reciclar las muertas moviendo la ultima viva a su lugar
+    i = 0;
+    while (i < n) {
+        if (life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        --n;
+        x[i] = x[n];
+        y[i] = y[n];
+        vx[i] = vx[n];
+        vy[i] = vy[n];
+        life[i] = life[n];
+        pool.fade[i] = pool.fade[n];
+        pool.color[i] = pool.color[n];
+    }
+    pool.count = n;
+}
+
+SDL_Rect particleBounds(const ParticlePool& pool) {
+    if (pool.count == 0) {
+        return {0, 0, 0, 0};
+    }
+    float minX = pool.x[0], maxX = pool.x[0];
+    float minY = pool.y[0], maxY = pool.y[0];
+    for (int i = 1; i < pool.count; ++i) {
+        minX = std::min(minX, pool.x[i]);
+        maxX = std::max(maxX, pool.x[i]);
+        minY = std::min(minY, pool.y[i]);
+        maxY = std::max(maxY, pool.y[i]);
+    }
+    int x0 = static_cast<int>(std::floor(minX));
+    int y0 = static_cast<int>(std::floor(minY));
+    return {x0, y0, static_cast<int>(std::ceil(maxX + PARTICLE_SIZE)) - x0, static_cast<int>(std::ceil(maxY + PARTICLE_SIZE)) - y0};
+}
+
+void renderParticles(RenderQueue& queue, ParticlePool& pool, const Camera& camera) {
+    PROFILE_ZONE("renderParticles");
+    if (pool.count == 0) {
+        return;
+    }
+
+    SDL_Vertex* v = pool.vertices.data();
+    for (int i = 0; i < pool.count; ++i) {
+        SDL_Color c = pool.color[i];
+        c.a = static_cast<Uint8>(std::min(pool.life[i] * pool.fade[i], 1.0f) * 255.0f);
+        float x0 = worldToScreenX(camera, pool.x[i]);
+        float y0 = worldToScreenY(camera, pool.y[i]);
+        float x1 = x0 + PARTICLE_SIZE * camera.zoom;
+        float y1 = y0 + PARTICLE_SIZE * camera.zoom;
+        v[0] = {{x0, y0}, c, {0.0f, 0.0f}};
+        v[1] = {{x1, y0}, c, {0.0f, 0.0f}};
+        v[2] = {{x1, y1}, c, {0.0f, 0.0f}};
+        v[3] = {{x0, y1}, c, {0.0f, 0.0f}};
+        v += 4;
+    }
+
+    // Todas las particulas en un solo comando de geometria
+    queueGeometry(queue, LAYER_EFFECTS, nullptr, SDL_BLENDMODE_BLEND, pool.vertices.data(), pool.count * 4, pool.indices.data(), pool.count * 6);
+}
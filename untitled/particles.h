@@ -0,0 +1,37 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "render_queue.h"
+#include "camera.h"
+
+const int MAX_PARTICLES = 131072;
+const float PARTICLE_GRAVITY = 300.0f;
+const float PARTICLE_SIZE = 2.0f;
+
+// Pool de particulas en estructura de arreglos (SoA), capacidad fija.
+// Las particulas muertas se reciclan con swap-remove, asi las vivas
+// quedan siempre contiguas en [0, count).
+struct ParticlePool {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> life;
+    std::vector<float> fade; // 1 / vida inicial
+    std::vector<SDL_Color> color;
+    int count = 0;
+    int capacity = 0;
+    int dropped = 0;
+    Uint32 seed = 0x9E3779B9u;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+void initParticles(ParticlePool& pool, int capacity);
+void spawnParticle(ParticlePool& pool, float x, float y, float vx, float vy, float life, SDL_Color color);
+void spawnBlockDebris(ParticlePool& pool, const SDL_Rect& rect, SDL_Color color, int amount);
+void spawnTrail(ParticlePool& pool, const SDL_Rect& rect, SDL_Color color);
+void updateParticles(ParticlePool& pool, float dT);
+SDL_Rect particleBounds(const ParticlePool& pool);
+void renderParticles(RenderQueue& queue, ParticlePool& pool, const Camera& camera);
@@ -0,0 +1,72 @@
+# Build con PGO + LTO entrenado con las partidas sin ventana.
+#
+#   cmake -P pgo_build.cmake
+#   cmake -DGENERATOR=Ninja -P pgo_build.cmake
+#
+# 1. build-release: Release normal, la referencia
+# 2. build-pgo: Release + LTO instrumentado; corre el entrenamiento (los
+#    escenarios de estres y los benchmarks) y recompila con los perfiles
+# 3. Corre los mismos escenarios en los dos y deja la comparacion de
+#    ticks/s y tiempo de tick en build-pgo/pgo_report.txt
+cmake_minimum_required(VERSION 3.28)
+
+set(SOURCE_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(RELEASE_DIR ${SOURCE_DIR}/build-release)
+set(PGO_DIR ${SOURCE_DIR}/build-pgo)
+set(EXE "")
+if(CMAKE_HOST_WIN32)
+    set(EXE ".exe")
+endif()
+set(GENERATOR_ARGS "")
+if(GENERATOR)
+    set(GENERATOR_ARGS -G ${GENERATOR})
+endif()
+
+# Cada modo de entrenamiento es una corrida aparte del juego
+set(TRAINING_RUNS "--stress" "--bench-suite=training.json" "--bench-entities" "--bench-chain" "--bench-culling")
+
+function(run_step)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Step failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+function(configure_and_build dir)
+    run_step(${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${dir} ${GENERATOR_ARGS} -DCMAKE_BUILD_TYPE=Release ${ARGN})
+    run_step(${CMAKE_COMMAND} --build ${dir} --target untitled --config Release)
+endfunction()
+
+message(STATUS "Release build")
+configure_and_build(${RELEASE_DIR} -DGAME_LTO=OFF -DGAME_PGO=OFF)
+
+message(STATUS "Instrumented build")
+configure_and_build(${PGO_DIR} -DGAME_LTO=ON -DGAME_PGO=GENERATE)
+file(GLOB_RECURSE staleProfiles ${PGO_DIR}/*.gcda)
+if(staleProfiles)
+    file(REMOVE ${staleProfiles})
+endif()
+
+message(STATUS "Training")
+foreach(training ${TRAINING_RUNS})
+    message(STATUS "  untitled ${training}")
+    execute_process(COMMAND ${PGO_DIR}/untitled${EXE} ${training} WORKING_DIRECTORY ${PGO_DIR} OUTPUT_QUIET RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Training run ${training} failed (${result})")
+    endif()
+endforeach()
+
+message(STATUS "Optimized build")
+configure_and_build(${PGO_DIR} -DGAME_LTO=ON -DGAME_PGO=USE)
+
+# Mismos escenarios en los dos builds; el release hace de linea base
+message(STATUS "Comparing")
+run_step(${RELEASE_DIR}/untitled${EXE} --stress WORKING_DIRECTORY ${RELEASE_DIR})
+execute_process(COMMAND ${PGO_DIR}/untitled${EXE} --stress-baseline=${RELEASE_DIR}/stress.json
+                WORKING_DIRECTORY ${PGO_DIR} OUTPUT_FILE ${PGO_DIR}/pgo_report.txt RESULT_VARIABLE result)
+file(READ ${PGO_DIR}/pgo_report.txt report)
+message("${report}")
+if(NOT result EQUAL 0)
+    message(WARNING "The PGO build is slower than release in some scenario (see pgo_report.txt)")
+endif()
+message(STATUS "PGO build: ${PGO_DIR}/untitled${EXE}, report: ${PGO_DIR}/pgo_report.txt")
@@ -0,0 +1,62 @@
+#include "powerups.h"
+
+static const SDL_Color POWERUP_COLORS[POWERUP_TYPES] = {
+    {0x40, 0x80, 0xFF, 0xFF}, // Paddle ancho
+    {0xFF, 0x40, 0xFF, 0xFF}, // Multibola
+    {0x40, 0xFF, 0xFF, 0xFF}, // Pelota lenta
+    {0xFF, 0x40, 0x40, 0xFF}, // Laser
+};
+static const SDL_Color LASER_COLOR = {0xFF, 0xFF, 0x60, 0xFF};
+
+Entity spawnPowerUp(EntityWorld& world, float x, float y, PowerUpType type) {
+    // Tope fijo: una explosion en cadena no debe llenar el mundo de power-ups.
+    // Las creaciones pendientes del tick cuentan tambien.
+    if (entityCount(world, componentBit(COMPONENT_POWERUP)) + static_cast<int>(world.commands.size()) >= MAX_POWERUPS) {
+        return INVALID_HANDLE;
+    }
+    EntityInit init;
+    init.mask = POWERUP_COMPONENTS;
+    init.position = {x - POWERUP_WIDTH / 2.0f, y};
+    init.velocity = {0.0f, POWERUP_FALL_SPEED};
+    init.size = {POWERUP_WIDTH, POWERUP_HEIGHT};
+    init.color = POWERUP_COLORS[type];
+    init.kind = static_cast<Uint8>(type);
+    return createEntity(world, init);
+}
+
+// Una pasada sobre las columnas de los power-ups contra el paddle. Las
+// bajas quedan pendientes hasta el flush, asi no se mueve nada al recorrer.
+int collectPowerUps(EntityWorld& world, const SDL_Rect& paddle, int worldHeight, PowerUpType* collected, int maxCollected) {
+    const float left = static_cast<float>(paddle.x - POWERUP_WIDTH);
+    const float right = static_cast<float>(paddle.x + paddle.w);
+    const float top = static_cast<float>(paddle.y - POWERUP_HEIGHT);
+    const float bottom = static_cast<float>(paddle.y + paddle.h);
+    int caught = 0;
+
+    forEachChunk(world, componentBit(COMPONENT_POWERUP), [&](const Archetype& archetype, EntityChunk& chunk) {
+        const Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+        const Uint8* kind = chunkColumn<Uint8>(archetype, chunk, COMPONENT_KIND);
+        Entity* entities = chunkEntities(chunk);
+        for (int i = 0; i < chunk.count; ++i) {
+            float x = position[i].x, y = position[i].y;
+            bool hit = x > left && x < right && y > top && y < bottom;
+            if (hit && caught < maxCollected) {
+                collected[caught++] = static_cast<PowerUpType>(kind[i]);
+            }
+            if (hit || y > worldHeight) {
+                destroyEntity(world, entities[i]);
+            }
+        }
+    });
+    return caught;
+}
+
+Entity fireLaser(EntityWorld& world, float x, float y) {
+    EntityInit init;
+    init.mask = LASER_COMPONENTS;
+    init.position = {x, y};
+    init.velocity = {0.0f, -LASER_SPEED};
+    init.size = {LASER_WIDTH, LASER_HEIGHT};
+    init.color = LASER_COLOR;
+    return createEntity(world, init);
+}
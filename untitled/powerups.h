@@ -0,0 +1,49 @@
+#pragma once
+#include <SDL.h>
+#include "ecs.h"
+
+const int MAX_POWERUPS = 256;
+const int MAX_LASER_SHOTS = 128;
+const int POWERUP_WIDTH = 24;
+const int POWERUP_HEIGHT = 12;
+const float POWERUP_FALL_SPEED = 90.0f;
+const int LASER_WIDTH = 3;
+const int LASER_HEIGHT = 10;
+const float LASER_SPEED = 420.0f;
+
+enum PowerUpType {
+    POWERUP_WIDE,
+    POWERUP_MULTIBALL,
+    POWERUP_SLOW,
+    POWERUP_LASER,
+    POWERUP_TYPES
+};
+
+// Objetos que caen desde los bloques rotos hasta el paddle, y disparos
+// del laser que suben. Son entidades; el movimiento lo hace el sistema
+// general de posicion y velocidad.
+const ComponentMask POWERUP_COMPONENTS = componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_VELOCITY) | componentBit(COMPONENT_SIZE) |
+                                         componentBit(COMPONENT_COLOR) | componentBit(COMPONENT_KIND) | componentBit(COMPONENT_POWERUP);
+const ComponentMask LASER_COMPONENTS = componentBit(COMPONENT_POSITION) | componentBit(COMPONENT_VELOCITY) | componentBit(COMPONENT_SIZE) |
+                                       componentBit(COMPONENT_COLOR) | componentBit(COMPONENT_LASER);
+
+Entity spawnPowerUp(EntityWorld& world, float x, float y, PowerUpType type);
+int collectPowerUps(EntityWorld& world, const SDL_Rect& paddle, int worldHeight, PowerUpType* collected, int maxCollected);
+Entity fireLaser(EntityWorld& world, float x, float y);
+
+// Prueba cada disparo con hit(rect), que usa la misma consulta espacial de
+// bloques que la pelota y devuelve true si choco. Los que chocan o salen
+// del mundo se destruyen al final del tick.
+template <typename Hit>
+void hitLaserShots(EntityWorld& world, Hit&& hit) {
+    forEachChunk(world, componentBit(COMPONENT_LASER), [&](const Archetype& archetype, EntityChunk& chunk) {
+        const Position* position = chunkColumn<Position>(archetype, chunk, COMPONENT_POSITION);
+        Entity* entities = chunkEntities(chunk);
+        for (int i = 0; i < chunk.count; ++i) {
+            SDL_Rect rect = {static_cast<int>(position[i].x), static_cast<int>(position[i].y), LASER_WIDTH, LASER_HEIGHT};
+            if (rect.y + rect.h < 0 || hit(rect)) {
+                destroyEntity(world, entities[i]);
+            }
+        }
+    });
+}
@@ -0,0 +1,87 @@
+#include "profiler.h"
+
+#ifdef GAME_PROFILER
+#include <algorithm>
+#include <cstdio>
+
+thread_local ProfileBuffer* profileBuffer = nullptr;
+std::atomic<Uint32> profileCapture{0};
+
+// Buffers fijos, como los anillos del logger: registrar no reserva memoria
+static ProfileBuffer buffers[MAX_PROFILE_THREADS];
+static std::atomic<int> bufferCount{0};
+static Uint32 lastCapture = 0;
+static int framesLeft = 0;
+static Uint64 captureStart = 0;
+
+void registerProfileThread(const char* name) {
+    if (profileBuffer) {
+        return;
+    }
+    int index = bufferCount.fetch_add(1);
+    if (index >= MAX_PROFILE_THREADS) {
+        bufferCount.fetch_sub(1);
+        return;
+    }
+    buffers[index].name = name;
+    profileBuffer = &buffers[index];
+}
+
+void requestProfileCapture(int frames) {
+    if (profileCapture.load(std::memory_order_relaxed) != 0 || frames <= 0) {
+        return; // Ya hay una captura en curso
+    }
+    framesLeft = frames;
+    captureStart = SDL_GetPerformanceCounter();
+    profileCapture.store(++lastCapture, std::memory_order_release);
+}
+
+// Eventos "X" (inicio y duracion) en microsegundos desde el inicio de la captura
+static bool exportTrace(const char* path, Uint32 capture) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) {
+        std::fprintf(stderr, "Error opening %s\n", path);
+        return false;
+    }
+    double toMicros = 1e6 / static_cast<double>(SDL_GetPerformanceFrequency());
+    int events = 0, dropped = 0;
+    bool first = true;
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    int count = std::min(bufferCount.load(std::memory_order_acquire), MAX_PROFILE_THREADS);
+    for (int t = 0; t < count; ++t) {
+        ProfileBuffer& buffer = buffers[t];
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", t, buffer.name);
+        first = false;
+        if (buffer.capture.load(std::memory_order_acquire) != capture) {
+            continue;
+        }
+        int n = buffer.count.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) {
+            const ProfileEvent& e = buffer.events[i];
+            if (e.begin < captureStart) {
+                continue;
+            }
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", e.name, t,
+                         (e.begin - captureStart) * toMicros, (e.end - e.begin) * toMicros);
+            events++;
+        }
+        dropped += buffer.dropped;
+        buffer.dropped = 0;
+    }
+    std::fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    std::fclose(file);
+    std::fprintf(stderr, "Profile trace written to %s (%d zones, %d dropped)\n", path, events, dropped);
+    return true;
+}
+
+// Al final de cada frame: cuenta los frames de la captura y exporta al terminar
+void profileFrame() {
+    Uint32 capture = profileCapture.load(std::memory_order_relaxed);
+    if (capture == 0 || --framesLeft > 0) {
+        return;
+    }
+    profileCapture.store(0, std::memory_order_release);
+    exportTrace(PROFILE_TRACE_PATH, capture);
+}
+
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+#include <SDL.h>
+
+// Zonas de perfilado: PROFILE_ZONE("nombre") mide desde ahi hasta el fin
+// del bloque. Cada hilo guarda sus zonas en su propio buffer y al terminar
+// la captura se exportan como traza de Chrome/Perfetto (chrome://tracing).
+// Sin GAME_PROFILER todo esto desaparece al compilar.
+const int PROFILE_HOTKEY_FRAMES = 120;
+const char* const PROFILE_TRACE_PATH = "trace.json";
+
+#ifdef GAME_PROFILER
+#include <atomic>
+
+const int PROFILE_BUFFER_SIZE = 16384;
+const int MAX_PROFILE_THREADS = 16;
+
+struct ProfileEvent {
+    const char* name; // Literal: solo se guarda el puntero
+    Uint64 begin;
+    Uint64 end;
+};
+
+struct ProfileBuffer {
+    std::atomic<Uint32> capture{0}; // Captura a la que pertenecen los eventos
+    std::atomic<int> count{0};
+    int dropped = 0;
+    const char* name = "";
+    ProfileEvent events[PROFILE_BUFFER_SIZE];
+};
+
+extern thread_local ProfileBuffer* profileBuffer;
+extern std::atomic<Uint32> profileCapture; // 0 si no se esta capturando
+
+void registerProfileThread(const char* name);
+void requestProfileCapture(int frames);
+void profileFrame();
+
+inline void profileRecord(const char* name, Uint64 begin, Uint64 end) {
+    ProfileBuffer* buffer = profileBuffer;
+    Uint32 capture = profileCapture.load(std::memory_order_acquire);
+    if (!buffer || capture == 0) {
+        return;
+    }
+    // El primer evento de una captura nueva vacia el buffer del hilo
+    if (buffer->capture.load(std::memory_order_relaxed) != capture) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->capture.store(capture, std::memory_order_release);
+    }
+    int n = buffer->count.load(std::memory_order_relaxed);
+    if (n == PROFILE_BUFFER_SIZE) {
+        buffer->dropped++;
+        return;
+    }
+    buffer->events[n] = {name, begin, end};
+    buffer->count.store(n + 1, std::memory_order_release);
+}
+
+struct ProfileZone {
+    const char* name;
+    Uint64 begin;
+    explicit ProfileZone(const char* zoneName) : name(zoneName), begin(0) {
+        if (profileCapture.load(std::memory_order_relaxed) != 0) {
+            begin = SDL_GetPerformanceCounter();
+        }
+    }
+    ~ProfileZone() {
+        if (begin != 0) {
+            profileRecord(name, begin, SDL_GetPerformanceCounter());
+        }
+    }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+
+#else
+
+inline void registerProfileThread(const char*) {}
+inline void requestProfileCapture(int) {}
+inline void profileFrame() {}
+
+#define PROFILE_ZONE(name) ((void)0)
+
+#endif
@@ -0,0 +1,310 @@
+#include "render_queue.h"
+#include "cpu_renderer.h"
+#include "profiler.h"
+#include <algorithm>
+
+static int textureId(RenderQueue& queue, SDL_Texture* texture) {
+    if (!texture) {
+        return 0;
+    }
+    for (int i = 1; i <= queue.textureCount; ++i) {
+        if (queue.textures[i] == texture) {
+            return i;
+        }
+    }
+    if (queue.textureCount == MAX_RENDER_TEXTURES) {
+        return MAX_RENDER_TEXTURES;
+    }
+    queue.textures[++queue.textureCount] = texture;
+    return queue.textureCount;
+}
+
+static Uint64 packKey(RenderQueue& queue, RenderLayer layer, const RenderCommand& c) {
+    Uint32 color = c.type == CMD_RECT ? (static_cast<Uint32>(c.color.r) << 24) | (c.color.g << 16) | (c.color.b << 8) | c.color.a : 0;
+    return (static_cast<Uint64>(layer) << 60) |
+           (static_cast<Uint64>(textureId(queue, c.texture)) << 52) |
+           (static_cast<Uint64>(c.blend & 0xF) << 48) |
+           (static_cast<Uint64>(c.type) << 44) |
+           (static_cast<Uint64>(color) << 12);
+}
+
+static RenderCommand* pushCommand(RenderQueue& queue) {
+    if (queue.count >= queue.capacity) {
+        queue.dropped++;
+        return nullptr;
+    }
+    return &queue.commands[queue.count];
+}
+
+static void commitCommand(RenderQueue& queue, RenderLayer layer) {
+    queue.order[queue.count] = {packKey(queue, layer, queue.commands[queue.count]), static_cast<Uint32>(queue.count)};
+    queue.count++;
+}
+
+void beginRenderQueue(RenderQueue& queue, FrameArena& arena) {
+    queue.arena = &arena;
+    queue.commands = arenaAllocArray<RenderCommand>(arena, MAX_RENDER_COMMANDS);
+    queue.order = arenaAllocArray<RenderSortEntry>(arena, MAX_RENDER_COMMANDS);
+    queue.capacity = (queue.commands && queue.order) ? MAX_RENDER_COMMANDS : 0;
+    queue.count = 0;
+    queue.dropped = 0;
+    queue.sorted = false;
+    queue.drawCalls = 0;
+    queue.stateChanges = 0;
+}
+
+void queueRect(RenderQueue& queue, RenderLayer layer, const SDL_Rect& rect, SDL_Color color) {
+    RenderCommand* c = pushCommand(queue);
+    if (!c) {
+        return;
+    }
+    c->type = CMD_RECT;
+    c->texture = nullptr;
+    c->blend = color.a == 0xFF ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND;
+    c->color = color;
+    c->rect = rect;
+    commitCommand(queue, layer);
+}
+
+void queueSprite(RenderQueue& queue, RenderLayer layer, SDL_Texture* texture, const SDL_Rect& dst,
+                 float u0, float v0, float u1, float v1, SDL_Color tint) {
+    RenderCommand* c = pushCommand(queue);
+    if (!c) {
+        return;
+    }
+    c->type = CMD_SPRITE;
+    c->texture = texture;
+    c->blend = SDL_BLENDMODE_BLEND;
+    c->color = tint;
+    c->rect = dst;
+    c->u0 = u0;
+    c->v0 = v0;
+    c->u1 = u1;
+    c->v1 = v1;
+    commitCommand(queue, layer);
+}
+
+void queueGeometry(RenderQueue& queue, RenderLayer layer, SDL_Texture* texture, SDL_BlendMode blend,
+                   const SDL_Vertex* vertices, int numVertices, const int* indices, int numIndices) {
+    RenderCommand* c = pushCommand(queue);
+    if (!c) {
+        return;
+    }
+    c->type = CMD_GEOMETRY;
+    c->texture = texture;
+    c->blend = blend;
+    c->color = {0xFF, 0xFF, 0xFF, 0xFF};
+    c->vertices = vertices;
+    c->numVertices = numVertices;
+    c->indices = indices;
+    c->numIndices = numIndices;
+    commitCommand(queue, layer);
+}
+
+// Estado actual del renderer durante el envio, para no repetir llamadas
+struct SubmitState {
+    bool hasColor = false;
+    SDL_Color color = {0, 0, 0, 0};
+    int drawBlend = -1;
+    int textureBlend[MAX_RENDER_TEXTURES + 1];
+    SDL_Texture* lastTexture = nullptr;
+    bool first = true;
+};
+
+static void setDrawColor(RenderQueue& queue, SubmitState& state, SDL_Renderer* renderer, SDL_Color c) {
+    if (state.hasColor && state.color.r == c.r && state.color.g == c.g && state.color.b == c.b && state.color.a == c.a) {
+        return;
+    }
+    SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+    state.hasColor = true;
+    state.color = c;
+    queue.stateChanges++;
+}
+
+static void setBlend(RenderQueue& queue, SubmitState& state, SDL_Renderer* renderer, SDL_Texture* texture, SDL_BlendMode blend) {
+    if (texture) {
+        int id = textureId(queue, texture);
+        if (state.textureBlend[id] != blend) {
+            SDL_SetTextureBlendMode(texture, blend);
+            state.textureBlend[id] = blend;
+            queue.stateChanges++;
+        }
+    } else if (state.drawBlend != blend) {
+        SDL_SetRenderDrawBlendMode(renderer, blend);
+        state.drawBlend = blend;
+        queue.stateChanges++;
+    }
+}
+
+static void bindTexture(RenderQueue& queue, SubmitState& state, SDL_Texture* texture) {
+    if (state.first || state.lastTexture != texture) {
+        queue.stateChanges++;
+    }
+    state.first = false;
+    state.lastTexture = texture;
+}
+
+static void sortQueue(RenderQueue& queue) {
+    if (queue.sorted) {
+        return;
+    }
+    queue.sorted = true;
+    std::sort(queue.order, queue.order + queue.count, [](const RenderSortEntry& a, const RenderSortEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.index < b.index;
+    });
+}
+
+static bool visible(const RenderCommand& c, const SDL_Rect* clip) {
+    return !clip || SDL_HasIntersection(&c.rect, clip);
+}
+
+static void submitRects(RenderQueue& queue, SubmitState& state, SDL_Renderer* renderer, int begin, int end, const SDL_Rect* clip) {
+    int n = end - begin;
+    SDL_Rect* rects = arenaAllocArray<SDL_Rect>(*queue.arena, n);
+    int count = 0;
+    for (int i = begin; i < end; ++i) {
+        const RenderCommand& c = queue.commands[queue.order[i].index];
+        if (!visible(c, clip)) {
+            continue;
+        }
+        if (count == 0) {
+            setBlend(queue, state, renderer, nullptr, c.blend);
+            setDrawColor(queue, state, renderer, c.color);
+        }
+        if (rects) {
+            rects[count] = c.rect;
+        } else {
+            SDL_RenderFillRect(renderer, &c.rect);
+            queue.drawCalls++;
+        }
+        count++;
+    }
+    if (rects && count > 0) {
+        SDL_RenderFillRects(renderer, rects, count);
+        queue.drawCalls++;
+    }
+}
+
+static void spriteQuad(const RenderCommand& c, SDL_Vertex* v) {
+    float x0 = static_cast<float>(c.rect.x);
+    float y0 = static_cast<float>(c.rect.y);
+    float x1 = x0 + c.rect.w;
+    float y1 = y0 + c.rect.h;
+    v[0] = {{x0, y0}, c.color, {c.u0, c.v0}};
+    v[1] = {{x1, y0}, c.color, {c.u1, c.v0}};
+    v[2] = {{x1, y1}, c.color, {c.u1, c.v1}};
+    v[3] = {{x0, y1}, c.color, {c.u0, c.v1}};
+}
+
+static void submitSprites(RenderQueue& queue, SubmitState& state, SDL_Renderer* renderer, int begin, int end, const SDL_Rect* clip) {
+    static const int QUAD[6] = {0, 1, 2, 2, 3, 0};
+    const RenderCommand& first = queue.commands[queue.order[begin].index];
+    int n = end - begin;
+    SDL_Vertex* vertices = arenaAllocArray<SDL_Vertex>(*queue.arena, n * 4);
+    int* indices = arenaAllocArray<int>(*queue.arena, n * 6);
+    int count = 0;
+    for (int i = begin; i < end; ++i) {
+        const RenderCommand& c = queue.commands[queue.order[i].index];
+        if (!visible(c, clip)) {
+            continue;
+        }
+        if (count == 0) {
+            setBlend(queue, state, renderer, first.texture, first.blend);
+            bindTexture(queue, state, first.texture);
+        }
+        if (vertices && indices) {
+            spriteQuad(c, vertices + count * 4);
+            for (int k = 0; k < 6; ++k) {
+                indices[count * 6 + k] = count * 4 + QUAD[k];
+            }
+        } else {
+            SDL_Vertex v[4];
+            spriteQuad(c, v);
+            SDL_RenderGeometry(renderer, first.texture, v, 4, QUAD, 6);
+            queue.drawCalls++;
+        }
+        count++;
+    }
+    if (vertices && indices && count > 0) {
+        SDL_RenderGeometry(renderer, first.texture, vertices, count * 4, indices, count * 6);
+        queue.drawCalls++;
+    }
+}
+
+static void submit(RenderQueue& queue, SDL_Renderer* renderer, bool texturedOnly, const SDL_Rect* clip) {
+    SubmitState state;
+    std::fill(state.textureBlend, state.textureBlend + MAX_RENDER_TEXTURES + 1, -1);
+
+    int i = 0;
+    while (i < queue.count) {
+        const RenderCommand& c = queue.commands[queue.order[i].index];
+        int end = i + 1;
+        while (end < queue.count && queue.order[end].key == queue.order[i].key) {
+            ++end;
+        }
+        if (texturedOnly && !c.texture) {
+            i = end;
+            continue;
+        }
+
+        if (c.type == CMD_RECT) {
+            submitRects(queue, state, renderer, i, end, clip);
+        } else if (c.type == CMD_SPRITE) {
+            submitSprites(queue, state, renderer, i, end, clip);
+        } else {
+            for (int k = i; k < end; ++k) {
+                const RenderCommand& g = queue.commands[queue.order[k].index];
+                setBlend(queue, state, renderer, g.texture, g.blend);
+                bindTexture(queue, state, g.texture);
+                SDL_RenderGeometry(renderer, g.texture, g.vertices, g.numVertices, g.indices, g.numIndices);
+                queue.drawCalls++;
+            }
+        }
+        i = end;
+    }
+}
+
+void flushRenderQueue(RenderQueue& queue, SDL_Renderer* renderer) {
+    PROFILE_ZONE("flushRenderQueue");
+    sortQueue(queue);
+    submit(queue, renderer, false, nullptr);
+}
+
+// Solo lo que toca `clip`; la geometria se envia entera y la recorta SDL
+void flushRenderQueueClipped(RenderQueue& queue, SDL_Renderer* renderer, const SDL_Rect& clip) {
+    PROFILE_ZONE("flushRenderQueue");
+    sortQueue(queue);
+    SDL_RenderSetClipRect(renderer, &clip);
+    submit(queue, renderer, false, &clip);
+    SDL_RenderSetClipRect(renderer, NULL);
+}
+
+void flushRenderQueueCpu(RenderQueue& queue, CpuRenderer& cpu, SDL_Renderer* renderer) {
+    PROFILE_ZONE("flushRenderQueue");
+    sortQueue(queue);
+
+    // Lo que no lleva textura lo rasteriza la CPU; la geometria se trata
+    // como quads alineados a los ejes, sin mezcla alfa
+    for (int i = 0; i < queue.count; ++i) {
+        const RenderCommand& c = queue.commands[queue.order[i].index];
+        if (c.texture) {
+            continue;
+        }
+        if (c.type == CMD_RECT) {
+            cpuFillRect(cpu, c.rect, c.color);
+            continue;
+        }
+        for (int v = 0; v + 3 < c.numVertices; v += 4) {
+            const SDL_Vertex* q = c.vertices + v;
+            float a = q[0].color.a / 255.0f;
+            SDL_Rect r = {static_cast<int>(q[0].position.x), static_cast<int>(q[0].position.y),
+                          static_cast<int>(q[2].position.x - q[0].position.x), static_cast<int>(q[2].position.y - q[0].position.y)};
+            SDL_Color faded = {static_cast<Uint8>(q[0].color.r * a), static_cast<Uint8>(q[0].color.g * a), static_cast<Uint8>(q[0].color.b * a), 0xFF};
+            cpuFillRect(cpu, r, faded);
+        }
+    }
+    cpuPresent(cpu, renderer);
+    queue.drawCalls++;
+
+    submit(queue, renderer, true, nullptr);
+}
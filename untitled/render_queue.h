@@ -0,0 +1,70 @@
+#pragma once
+#include <SDL.h>
+#include "arena.h"
+
+struct CpuRenderer;
+
+const int MAX_RENDER_COMMANDS = 131072;
+const int MAX_RENDER_TEXTURES = 255;
+const size_t RENDER_ARENA_SIZE = 32 * 1024 * 1024;
+
+// Las capas se dibujan en orden; dentro de una capa el orden lo decide el estado
+enum RenderLayer {
+    LAYER_BORDERS,
+    LAYER_WORLD,
+    LAYER_EFFECTS,
+    LAYER_HUD
+};
+
+enum RenderCommandType {
+    CMD_RECT,
+    CMD_SPRITE,
+    CMD_GEOMETRY
+};
+
+struct RenderCommand {
+    RenderCommandType type;
+    SDL_Texture* texture;
+    SDL_BlendMode blend;
+    SDL_Color color;
+    SDL_Rect rect;
+    float u0, v0, u1, v1;
+    const SDL_Vertex* vertices;
+    const int* indices;
+    int numVertices;
+    int numIndices;
+};
+
+struct RenderSortEntry {
+    Uint64 key;
+    Uint32 index;
+};
+
+// Buffer de comandos del frame. Todo se graba aqui (en la arena del frame),
+// se ordena por una clave de estado empaquetada (capa, textura, blend, color)
+// y se envia a SDL con el minimo de cambios de estado.
+struct RenderQueue {
+    FrameArena* arena = nullptr;
+    RenderCommand* commands = nullptr;
+    RenderSortEntry* order = nullptr;
+    int count = 0;
+    int capacity = 0;
+    int dropped = 0;
+    bool sorted = false;
+
+    SDL_Texture* textures[MAX_RENDER_TEXTURES + 1] = {};
+    int textureCount = 0;
+
+    int drawCalls = 0;
+    int stateChanges = 0;
+};
+
+void beginRenderQueue(RenderQueue& queue, FrameArena& arena);
+void queueRect(RenderQueue& queue, RenderLayer layer, const SDL_Rect& rect, SDL_Color color);
+void queueSprite(RenderQueue& queue, RenderLayer layer, SDL_Texture* texture, const SDL_Rect& dst,
+                 float u0, float v0, float u1, float v1, SDL_Color tint);
+void queueGeometry(RenderQueue& queue, RenderLayer layer, SDL_Texture* texture, SDL_BlendMode blend,
+                   const SDL_Vertex* vertices, int numVertices, const int* indices, int numIndices);
+void flushRenderQueue(RenderQueue& queue, SDL_Renderer* renderer);
+void flushRenderQueueClipped(RenderQueue& queue, SDL_Renderer* renderer, const SDL_Rect& clip);
+void flushRenderQueueCpu(RenderQueue& queue, CpuRenderer& cpu, SDL_Renderer* renderer);
@@ -0,0 +1,106 @@
+#include "resolution.h"
+#include <algorithm>
+#include <cmath>
+
+static void applyScale(ResolutionScaler& scaler) {
+    scaler.width = std::max(1, static_cast<int>(std::lround(scaler.windowWidth * scaler.scale)));
+    scaler.height = std::max(1, static_cast<int>(std::lround(scaler.windowHeight * scaler.scale)));
+}
+
+bool initResolutionScaler(ResolutionScaler& scaler, SDL_Renderer* renderer, int logicalWidth, int logicalHeight) {
+    scaler.logicalWidth = logicalWidth;
+    scaler.logicalHeight = logicalHeight;
+    if (!SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
+    return resizeResolutionScaler(scaler, renderer);
+}
+
+// La textura se crea al tamano de la ventana; las escalas menores usan solo una parte
+bool resizeResolutionScaler(ResolutionScaler& scaler, SDL_Renderer* renderer) {
+    int w = 0, h = 0;
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    if (scaler.target && w == scaler.windowWidth && h == scaler.windowHeight) {
+        return true;
+    }
+    if (scaler.target) {
+        SDL_DestroyTexture(scaler.target);
+    }
+    scaler.windowWidth = w;
+    scaler.windowHeight = h;
+    scaler.target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    applyScale(scaler);
+    return scaler.target != nullptr;
+}
+
+void destroyResolutionScaler(ResolutionScaler& scaler) {
+    if (scaler.target) {
+        SDL_DestroyTexture(scaler.target);
+        scaler.target = nullptr;
+    }
+}
+
+void beginScaledFrame(ResolutionScaler& scaler, SDL_Renderer* renderer) {
+    SDL_SetRenderTarget(renderer, scaler.target);
+    SDL_Rect viewport = {0, 0, scaler.width, scaler.height};
+    SDL_RenderSetViewport(renderer, &viewport);
+    SDL_RenderSetScale(renderer, static_cast<float>(scaler.width) / scaler.logicalWidth,
+                       static_cast<float>(scaler.height) / scaler.logicalHeight);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+    SDL_RenderClear(renderer);
+}
+
+void endScaledFrame(ResolutionScaler& scaler, SDL_Renderer* renderer) {
+    SDL_SetRenderTarget(renderer, NULL);
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_RenderSetViewport(renderer, NULL);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+    SDL_RenderClear(renderer);
+
+    // Mantener la proporcion del mundo con franjas negras
+    float fit = std::min(static_cast<float>(scaler.windowWidth) / scaler.logicalWidth,
+                         static_cast<float>(scaler.windowHeight) / scaler.logicalHeight);
+    int w = static_cast<int>(scaler.logicalWidth * fit);
+    int h = static_cast<int>(scaler.logicalHeight * fit);
+    SDL_Rect src = {0, 0, scaler.width, scaler.height};
+    SDL_Rect dst = {(scaler.windowWidth - w) / 2, (scaler.windowHeight - h) / 2, w, h};
+    SDL_RenderCopy(renderer, scaler.target, &src, &dst);
+}
+
+void updateResolutionScaler(ResolutionScaler& scaler, float renderMs) {
+    scaler.averageMs = scaler.averageMs == 0.0f ? renderMs : scaler.averageMs * 0.9f + renderMs * 0.1f;
+
+    // Banda muerta entre 60% y 90% del presupuesto para no oscilar
+    if (scaler.averageMs > scaler.budgetMs * 0.9f) {
+        scaler.framesOver++;
+        scaler.framesUnder = 0;
+    } else if (scaler.averageMs < scaler.budgetMs * 0.6f) {
+        scaler.framesUnder++;
+        scaler.framesOver = 0;
+    } else {
+        scaler.framesOver = 0;
+        scaler.framesUnder = 0;
+    }
+
+    // Bajar rapido: primero efectos, luego resolucion
+    if (scaler.framesOver >= FRAMES_BEFORE_DOWNSCALE) {
+        scaler.framesOver = 0;
+        if (scaler.effectQuality > 0) {
+            scaler.effectQuality--;
+        } else if (scaler.scale > MIN_RESOLUTION_SCALE) {
+            scaler.scale = std::max(MIN_RESOLUTION_SCALE, scaler.scale - RESOLUTION_STEP);
+            applyScale(scaler);
+        }
+    }
+
+    // Subir despacio: primero resolucion, luego efectos
+    if (scaler.framesUnder >= FRAMES_BEFORE_UPSCALE) {
+        scaler.framesUnder = 0;
+        if (scaler.scale < 1.0f) {
+            scaler.scale = std::min(1.0f, scaler.scale + RESOLUTION_STEP);
+            applyScale(scaler);
+        } else if (scaler.effectQuality < MAX_EFFECT_QUALITY) {
+            scaler.effectQuality++;
+        }
+    }
+}
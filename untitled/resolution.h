@@ -0,0 +1,35 @@
+#pragma once
+#include <SDL.h>
+
+const float DEFAULT_FRAME_BUDGET_MS = 16.6f;
+const float MIN_RESOLUTION_SCALE = 0.5f;
+const float RESOLUTION_STEP = 0.1f;
+const int MAX_EFFECT_QUALITY = 2;
+const int FRAMES_BEFORE_DOWNSCALE = 30;
+const int FRAMES_BEFORE_UPSCALE = 120;
+
+// Se dibuja a una resolucion interna dentro de una textura y se escala a
+// la ventana. La resolucion y la calidad de efectos se ajustan segun el
+// tiempo de render medido contra el presupuesto del frame.
+struct ResolutionScaler {
+    SDL_Texture* target = nullptr;
+    int windowWidth = 0;
+    int windowHeight = 0;
+    int logicalWidth = 0;
+    int logicalHeight = 0;
+    int width = 0;  // Resolucion interna actual
+    int height = 0;
+    float scale = 1.0f;
+    int effectQuality = MAX_EFFECT_QUALITY;
+    float budgetMs = DEFAULT_FRAME_BUDGET_MS;
+    float averageMs = 0.0f;
+    int framesOver = 0;
+    int framesUnder = 0;
+};
+
+bool initResolutionScaler(ResolutionScaler& scaler, SDL_Renderer* renderer, int logicalWidth, int logicalHeight);
+bool resizeResolutionScaler(ResolutionScaler& scaler, SDL_Renderer* renderer);
+void destroyResolutionScaler(ResolutionScaler& scaler);
+void beginScaledFrame(ResolutionScaler& scaler, SDL_Renderer* renderer);
+void endScaledFrame(ResolutionScaler& scaler, SDL_Renderer* renderer);
+void updateResolutionScaler(ResolutionScaler& scaler, float renderMs);
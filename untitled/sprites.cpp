@@ -0,0 +1,202 @@
+#include "sprites.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static const char* SPRITE_NAMES[SPRITE_COUNT] = {"block", "paddle", "ball"};
+static const int SPRITE_DEFAULT_SIZE[SPRITE_COUNT][2] = {{64, 20}, {100, 20}, {13, 13}};
+
+static Uint32 gray(int v, int a = 0xFF) {
+    v = std::max(0, std::min(255, v));
+    return (static_cast<Uint32>(a) << 24) | (v << 16) | (v << 8) | v;
+}
+
+// Arte generado en escala de grises; el color final viene del tinte
+static SDL_Surface* generateSprite(int id) {
+    int w = SPRITE_DEFAULT_SIZE[id][0];
+    int h = SPRITE_DEFAULT_SIZE[id][1];
+    SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!s) {
+        return nullptr;
+    }
+    for (int y = 0; y < h; ++y) {
+        Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(s->pixels) + y * s->pitch);
+        for (int x = 0; x < w; ++x) {
+            Uint32 p = 0;
+            if (id == SPRITE_BALL) {
+                float dx = x + 0.5f - w / 2.0f;
+                float dy = y + 0.5f - h / 2.0f;
+                float d = std::sqrt(dx * dx + dy * dy) / (w / 2.0f);
+                if (d <= 1.0f) {
+                    p = gray(255 - static_cast<int>(d * 90.0f) + (dx + dy < -3.0f ? 30 : 0));
+                }
+            } else if (x == 0 || y == 0 || x == w - 1 || y == h - 1) {
+                p = gray(0); // Borde negro
+            } else if (y <= 2 || x <= 1) {
+                p = gray(255); // Bisel claro
+            } else if (y >= h - 3 || x >= w - 2) {
+                p = gray(150); // Bisel oscuro
+            } else {
+                p = gray(220 - y * 2);
+            }
+            row[x] = p;
+        }
+    }
+    return s;
+}
+
+// Del paquete si lo hay y tiene la imagen, si no del archivo suelto
+static std::string spritePath(int id) {
+    return std::string("assets/") + SPRITE_NAMES[id] + ".bmp";
+}
+
+static SDL_Surface* loadSprite(int id, const AssetPack* pack, std::vector<unsigned char>& scratch) {
+    std::string path = spritePath(id);
+    const PackEntry* entry = pack ? findAsset(*pack, path.c_str()) : nullptr;
+    const unsigned char* data = entry ? assetData(*pack, *entry, scratch) : nullptr;
+    SDL_Surface* loaded = data ? SDL_LoadBMP_RW(SDL_RWFromConstMem(data, static_cast<int>(entry->size)), 1)
+                               : SDL_LoadBMP(path.c_str());
+    if (!loaded) {
+        return generateSprite(id);
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    return converted ? converted : generateSprite(id);
+}
+
+// Empaquetado por estantes: de mas alto a mas bajo, izquierda a derecha
+static bool packShelves(SDL_Surface** images, SDL_Rect* placed, int size) {
+    int order[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        order[i] = i;
+    }
+    std::sort(order, order + SPRITE_COUNT, [&](int a, int b) { return images[a]->h > images[b]->h; });
+
+    int x = 0, y = 0, shelfHeight = 0;
+    for (int k = 0; k < SPRITE_COUNT; ++k) {
+        int i = order[k];
+        int w = images[i]->w + SPRITE_PADDING;
+        int h = images[i]->h + SPRITE_PADDING;
+        if (x + w > size) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (w > size || y + h > size) {
+            return false;
+        }
+        placed[i] = {x, y, images[i]->w, images[i]->h};
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+    return true;
+}
+
+bool loadSpriteAtlas(SDL_Renderer* renderer, SpriteAtlas& atlas, const AssetPack* pack, bool placeholders) {
+    SDL_Surface* images[SPRITE_COUNT] = {};
+    std::vector<unsigned char> scratch;
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        images[i] = placeholders ? generateSprite(i) : loadSprite(i, pack, scratch);
+        if (!images[i]) {
+            for (int j = 0; j < i; ++j) {
+                SDL_FreeSurface(images[j]);
+            }
+            return false;
+        }
+    }
+
+    SDL_Rect placed[SPRITE_COUNT];
+    int size = SPRITE_ATLAS_MIN_SIZE;
+    while (size <= SPRITE_ATLAS_MAX_SIZE && !packShelves(images, placed, size)) {
+        size *= 2;
+    }
+
+    SDL_Surface* sheet = size <= SPRITE_ATLAS_MAX_SIZE ? SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888) : nullptr;
+    if (sheet) {
+        SDL_FillRect(sheet, NULL, 0);
+        for (int i = 0; i < SPRITE_COUNT; ++i) {
+            for (int y = 0; y < images[i]->h; ++y) {
+                const Uint8* src = static_cast<const Uint8*>(images[i]->pixels) + y * images[i]->pitch;
+                Uint8* dst = static_cast<Uint8*>(sheet->pixels) + (placed[i].y + y) * sheet->pitch + placed[i].x * 4;
+                std::copy(src, src + images[i]->w * 4, dst);
+            }
+            Sprite& sprite = atlas.sprites[i];
+            sprite.src = placed[i];
+            sprite.u0 = static_cast<float>(placed[i].x) / size;
+            sprite.v0 = static_cast<float>(placed[i].y) / size;
+            sprite.u1 = static_cast<float>(placed[i].x + placed[i].w) / size;
+            sprite.v1 = static_cast<float>(placed[i].y + placed[i].h) / size;
+        }
+        atlas.texture = SDL_CreateTextureFromSurface(renderer, sheet);
+        atlas.width = size;
+        atlas.height = size;
+        SDL_FreeSurface(sheet);
+    }
+
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        SDL_FreeSurface(images[i]);
+    }
+    if (!atlas.texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void streamSpriteArt(AssetStreamer& streamer, const SpriteAtlas& atlas, Handle handles[SPRITE_COUNT]) {
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        std::string path = spritePath(i);
+        bool exists = streamer.pack && findAsset(*streamer.pack, path.c_str());
+        if (!exists) {
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            exists = file != nullptr;
+            if (file) {
+                std::fclose(file);
+            }
+        }
+        handles[i] = exists ? requestTextureRegion(streamer, path.c_str(), atlas.texture, atlas.sprites[i].src) : INVALID_HANDLE;
+    }
+}
+
+void destroySpriteAtlas(SpriteAtlas& atlas) {
+    if (atlas.texture) {
+        SDL_DestroyTexture(atlas.texture);
+        atlas.texture = nullptr;
+    }
+}
+
+void drawSprite(RenderQueue& queue, const SpriteAtlas& atlas, SpriteId id, const SDL_Rect& dst, SDL_Color tint) {
+    const Sprite& s = atlas.sprites[id];
+    queueSprite(queue, LAYER_WORLD, atlas.texture, dst, s.u0, s.v0, s.u1, s.v1, tint);
+}
+
+void benchmarkSprites(SDL_Renderer* renderer, const SpriteAtlas& atlas, int width, int height) {
+    const int counts[] = {1000, 5000, 10000, 25000, 50000, 100000};
+    const int frames = 60;
+    FrameArena arena;
+    RenderQueue queue;
+    Uint32 seed = 12345;
+    initFrameArena(arena, RENDER_ARENA_SIZE);
+
+    std::printf("sprites,frame_ms,fps\n");
+    for (int count : counts) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int f = 0; f < frames; ++f) {
+            resetFrameArena(arena);
+            beginRenderQueue(queue, arena);
+            SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+            SDL_RenderClear(renderer);
+            for (int i = 0; i < count; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                SDL_Rect dst = {static_cast<int>((seed >> 8) % width), static_cast<int>((seed >> 20) % height), 16, 8};
+                drawSprite(queue, atlas, static_cast<SpriteId>(i % SPRITE_COUNT), dst, {0x00, 0xFF, 0x00, 0xFF});
+            }
+            flushRenderQueue(queue, renderer);
+            SDL_RenderPresent(renderer);
+        }
+        float ms = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency() / frames;
+        std::printf("%d,%.3f,%.1f\n", count, ms, 1000.0f / ms);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <SDL.h>
+#include "asset_pack.h"
+#include "render_queue.h"
+#include "streaming.h"
+
+const int SPRITE_ATLAS_MIN_SIZE = 64;
+const int SPRITE_ATLAS_MAX_SIZE = 4096;
+const int SPRITE_PADDING = 1;
+
+enum SpriteId {
+    SPRITE_BLOCK,
+    SPRITE_PADDLE,
+    SPRITE_BALL,
+    SPRITE_COUNT
+};
+
+struct Sprite {
+    SDL_Rect src;
+    float u0, v0, u1, v1;
+};
+
+// Todas las imagenes del juego empaquetadas en una sola textura
+struct SpriteAtlas {
+    SDL_Texture* texture = nullptr;
+    int width = 0;
+    int height = 0;
+    Sprite sprites[SPRITE_COUNT];
+};
+
+// Con `pack` las imagenes se buscan primero en el paquete de assets. Con
+// `placeholders` no se lee nada: solo el arte generado, con los tamanos por
+// defecto, para reemplazarlo despues con streamSpriteArt.
+bool loadSpriteAtlas(SDL_Renderer* renderer, SpriteAtlas& atlas, const AssetPack* pack = nullptr, bool placeholders = false);
+// Pide en segundo plano las imagenes que existen (en el paquete o sueltas);
+// cada una se sube a su hueco del atlas. Deja INVALID_HANDLE en las demas.
+void streamSpriteArt(AssetStreamer& streamer, const SpriteAtlas& atlas, Handle handles[SPRITE_COUNT]);
+void destroySpriteAtlas(SpriteAtlas& atlas);
+// Los sprites se graban en la cola de render; al vaciarla se agrupan por textura
+void drawSprite(RenderQueue& queue, const SpriteAtlas& atlas, SpriteId id, const SDL_Rect& dst, SDL_Color tint);
+void benchmarkSprites(SDL_Renderer* renderer, const SpriteAtlas& atlas, int width, int height);
@@ -0,0 +1,64 @@
+#include "startup.h"
+#include <algorithm>
+#include <cstdio>
+
+static float msBetween(Uint64 from, Uint64 to) {
+    return (to - from) * 1000.0f / SDL_GetPerformanceFrequency();
+}
+
+void beginStartup(StartupTimeline& timeline) {
+    timeline.start = SDL_GetPerformanceCounter();
+    timeline.count = 0;
+    timeline.firstFrameMs = 0.0f;
+    timeline.finished = false;
+    timeline.verbose = false;
+}
+
+void recordStartupPhase(StartupTimeline& timeline, const char* name, Uint64 phaseStart, bool background) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    std::lock_guard<std::mutex> lock(timeline.mutex);
+    if (timeline.finished) {
+        if (timeline.verbose) {
+            std::printf("%s ready %.1f ms after start (%.1f ms, %s), after the first frame\n", name, msBetween(timeline.start, now),
+                        msBetween(phaseStart, now), background ? "loader" : "main");
+        }
+        return;
+    }
+    if (timeline.count == MAX_STARTUP_PHASES) {
+        return;
+    }
+    timeline.phases[timeline.count++] = {name, msBetween(timeline.start, phaseStart), msBetween(phaseStart, now), background};
+}
+
+void finishStartup(StartupTimeline& timeline, float budgetMs, bool verbose) {
+    std::lock_guard<std::mutex> lock(timeline.mutex);
+    timeline.finished = true;
+    timeline.verbose = verbose;
+    timeline.firstFrameMs = msBetween(timeline.start, SDL_GetPerformanceCounter());
+    std::sort(timeline.phases, timeline.phases + timeline.count,
+              [](const StartupPhase& a, const StartupPhase& b) { return a.startMs < b.startMs; });
+    // Solo el hilo principal retrasa el primer frame; lo de los hilos de
+    // carga cuenta solo si el principal tuvo que esperarlo
+    float mainMs = 0.0f;
+    int slowest = -1;
+    if (verbose) {
+        std::printf("phase,start_ms,ms,thread\n");
+    }
+    for (int i = 0; i < timeline.count; ++i) {
+        const StartupPhase& phase = timeline.phases[i];
+        if (verbose) {
+            std::printf("%s,%.2f,%.2f,%s\n", phase.name, phase.startMs, phase.ms, phase.background ? "loader" : "main");
+        }
+        if (!phase.background) {
+            mainMs += phase.ms;
+            if (slowest < 0 || phase.ms > timeline.phases[slowest].ms) {
+                slowest = i;
+            }
+        }
+    }
+    std::printf("First frame after %.1f ms (main thread phases %.1f ms, slowest %s %.1f ms)\n", timeline.firstFrameMs, mainMs,
+                slowest >= 0 ? timeline.phases[slowest].name : "-", slowest >= 0 ? timeline.phases[slowest].ms : 0.0f);
+    if (timeline.firstFrameMs > budgetMs) {
+        std::fprintf(stderr, "First frame took %.1f ms, over the %.0f ms startup budget\n", timeline.firstFrameMs, budgetMs);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <SDL.h>
+#include <mutex>
+
+const int MAX_STARTUP_PHASES = 32;
+const float FIRST_FRAME_BUDGET_MS = 250.0f; // Arranque en frio hasta el primer frame presentado
+
+struct StartupPhase {
+    const char* name;
+    float startMs; // Desde el inicio de main
+    float ms;
+    bool background; // Corrio en un hilo de carga, en paralelo al hilo principal
+};
+
+// Fases del arranque hasta el primer frame. Los hilos de carga tambien
+// anotan, por eso el mutex; despues de finishStartup la lista no cambia y
+// lo que termina tarde (el audio) se imprime aparte.
+struct StartupTimeline {
+    Uint64 start = 0;
+    StartupPhase phases[MAX_STARTUP_PHASES];
+    int count = 0;
+    float firstFrameMs = 0.0f;
+    bool finished = false;
+    bool verbose = false;
+    std::mutex mutex;
+};
+
+void beginStartup(StartupTimeline& timeline);
+// Anota la fase [phaseStart, ahora); phaseStart de SDL_GetPerformanceCounter.
+// Despues del primer frame no se guarda, solo se imprime si hay reporte.
+void recordStartupPhase(StartupTimeline& timeline, const char* name, Uint64 phaseStart, bool background = false);
+// Cierra la linea de tiempo con el primer frame presentado. Con `verbose`
+// imprime cada fase; si se paso de `budgetMs` avisa por stderr.
+void finishStartup(StartupTimeline& timeline, float budgetMs, bool verbose);
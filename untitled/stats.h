@@ -0,0 +1,39 @@
+#pragma once
+
+// Estadisticas de rendimiento que se muestran en el titulo de la ventana
+struct GameStats {
+    int fps = 0;
+    int particlesAlive = 0;
+    int particleCapacity = 0;
+    int particlesDropped = 0;
+    float particleUpdateMs = 0.0f;
+    int renderCommands = 0;
+    int drawCalls = 0;
+    int stateChanges = 0;
+    int dirtyRects = 0;
+    int pixelsTouched = 0;
+    float renderMs = 0.0f;
+    int cpuRectsDropped = 0; // Acumulado: el backend de CPU se quedo sin lugar
+    float resolutionScale = 1.0f;
+    int effectQuality = 0;
+    int blocksVisible = 0;
+    int chunksActive = 0;
+    float chunkGenerationMs = 0.0f;
+    int chunkStalls = 0;
+    int frameAllocations = 0;
+    int inputAllocations = 0;
+    int updateAllocations = 0;
+    int renderAllocations = 0;
+    int balls = 0;
+    int powerUps = 0;
+    int laserShots = 0;
+    float powerUpMs = 0.0f;
+    int entities = 0;
+    int entityChunks = 0;
+    int collisionTests = 0;
+    float frameMs = 0.0f;
+    float frameMsMax = 0.0f;
+    float ticksPerSecond = 0.0f;
+};
+
+extern GameStats stats;
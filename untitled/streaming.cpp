@@ -0,0 +1,538 @@
+#include "streaming.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "allocations.h"
+#include "logger.h"
+#include "profiler.h"
+
+static float msSince(Uint64 start) {
+    return (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+}
+
+static void pushSlot(std::vector<int>& queue, int head, int& count, int slot) {
+    queue[(head + count) % static_cast<int>(queue.size())] = slot;
+    count++;
+}
+
+static int popSlot(std::vector<int>& queue, int& head, int& count) {
+    int slot = queue[head];
+    head = (head + 1) % static_cast<int>(queue.size());
+    count--;
+    return slot;
+}
+
+static Handle slotHandle(const AssetStreamer& streamer, int slot) {
+    return (static_cast<Handle>(streamer.handles.generation[slot]) << 16) | static_cast<Handle>(slot);
+}
+
+// Ranura del handle, o -1 si ya no es valido
+static int assetSlot(const AssetStreamer& streamer, Handle handle) {
+    return denseIndex(streamer.handles, handle) >= 0 ? static_cast<int>(handle & 0xFFFF) : -1;
+}
+
+static StreamState lockedState(const AssetStreamer& streamer, int slot) {
+    std::lock_guard<std::mutex> lock(streamer.mutex);
+    return streamer.assets[slot].state;
+}
+
+static bool readLooseFile(const char* path, std::vector<unsigned char>& bytes) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(file) : -1;
+    ok = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        bytes.resize(static_cast<size_t>(size));
+        ok = std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    }
+    std::fclose(file);
+    return ok;
+}
+
+// Hilo de lectura: trae los bytes del paquete o del archivo suelto. Los
+// niveles se cargan enteros aca (mapear y validar) y se tocan todas sus
+// paginas, asi el cambio de nivel no espera al disco.
+static bool readStreamedAsset(AssetStreamer& streamer, StreamedAsset& asset) {
+    const PackEntry* entry = streamer.pack ? findAsset(*streamer.pack, asset.name) : nullptr;
+    if (asset.kind == STREAM_LEVEL) {
+        bool loaded = entry ? loadLevel(asset.level, *streamer.pack, asset.name) : loadLevel(asset.level, asset.name);
+        if (loaded) {
+            volatile int sink = 0;
+            const unsigned char* blocks = reinterpret_cast<const unsigned char*>(asset.level.blocks);
+            size_t bytes = asset.level.count * sizeof(Block);
+            for (size_t offset = 0; offset < bytes; offset += 4096) {
+                sink = sink + blocks[offset];
+            }
+        }
+        return loaded;
+    }
+    if (entry) {
+        asset.data = assetData(*streamer.pack, *entry, asset.bytes);
+        asset.size = static_cast<size_t>(entry->size);
+    } else if (readLooseFile(asset.name, asset.bytes)) {
+        asset.data = asset.bytes.data();
+        asset.size = asset.bytes.size();
+    }
+    if (!asset.data) {
+        std::cerr << "Error reading asset " << asset.name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static void readerLoop(AssetStreamer* streamer) {
+    registerLogThread("stream io");
+    registerProfileThread("stream io");
+    ignoreThreadAllocations();
+    std::unique_lock<std::mutex> lock(streamer->mutex);
+    while (true) {
+        streamer->wakeReader.wait(lock, [&] { return streamer->quit || streamer->readCount > 0; });
+        if (streamer->quit) {
+            return;
+        }
+        int slot = popSlot(streamer->readQueue, streamer->readHead, streamer->readCount);
+        StreamedAsset& asset = streamer->assets[slot];
+        lock.unlock();
+        Uint64 start = SDL_GetPerformanceCounter();
+        bool ok;
+        {
+            PROFILE_ZONE("read asset");
+            ok = readStreamedAsset(*streamer, asset);
+        }
+        asset.readMs = msSince(start);
+        lock.lock();
+        if (ok && asset.kind == STREAM_TEXTURE) {
+            asset.state = STREAM_READ;
+            pushSlot(streamer->decodeQueue, streamer->decodeHead, streamer->decodeCount, slot);
+            streamer->wakeDecoders.notify_one();
+        } else {
+            // Los niveles no tienen nada que decodificar ni subir
+            asset.state = ok ? STREAM_DECODED : STREAM_FAILED;
+            pushSlot(streamer->uploadQueue, streamer->uploadHead, streamer->uploadCount, slot);
+        }
+    }
+}
+
+static bool decodeStreamedAsset(StreamedAsset& asset) {
+    SDL_Surface* loaded = SDL_LoadBMP_RW(SDL_RWFromConstMem(asset.data, static_cast<int>(asset.size)), 1);
+    asset.surface = loaded ? SDL_ConvertSurfaceFormat(loaded, asset.format, 0) : nullptr;
+    SDL_FreeSurface(loaded);
+    std::vector<unsigned char>().swap(asset.bytes);
+    asset.data = nullptr;
+    if (!asset.surface) {
+        std::cerr << "Error decoding " << asset.name << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+    if (asset.target && (asset.surface->w != asset.region.w || asset.surface->h != asset.region.h)) {
+        std::cerr << "Asset " << asset.name << " is " << asset.surface->w << "x" << asset.surface->h << ", expected "
+                  << asset.region.w << "x" << asset.region.h << std::endl;
+        SDL_FreeSurface(asset.surface);
+        asset.surface = nullptr;
+        return false;
+    }
+    return true;
+}
+
+static void decoderLoop(AssetStreamer* streamer) {
+    registerLogThread("stream decode");
+    registerProfileThread("stream decode");
+    ignoreThreadAllocations();
+    std::unique_lock<std::mutex> lock(streamer->mutex);
+    while (true) {
+        streamer->wakeDecoders.wait(lock, [&] { return streamer->quit || streamer->decodeCount > 0; });
+        if (streamer->quit) {
+            return;
+        }
+        int slot = popSlot(streamer->decodeQueue, streamer->decodeHead, streamer->decodeCount);
+        StreamedAsset& asset = streamer->assets[slot];
+        lock.unlock();
+        Uint64 start = SDL_GetPerformanceCounter();
+        bool ok;
+        {
+            PROFILE_ZONE("decode asset");
+            ok = decodeStreamedAsset(asset);
+        }
+        asset.decodeMs = msSince(start);
+        lock.lock();
+        asset.state = ok ? STREAM_DECODED : STREAM_FAILED;
+        pushSlot(streamer->uploadQueue, streamer->uploadHead, streamer->uploadCount, slot);
+    }
+}
+
+bool initAssetStreamer(AssetStreamer& streamer, SDL_Renderer* renderer, const AssetPack* pack) {
+    streamer.renderer = renderer;
+    streamer.pack = pack && pack->header ? pack : nullptr;
+    streamer.quit = false;
+    streamer.stats = StreamStats();
+    initHandlePool(streamer.handles, MAX_STREAMED_ASSETS);
+    streamer.assets.resize(MAX_STREAMED_ASSETS);
+    streamer.readQueue.assign(MAX_STREAMED_ASSETS, 0);
+    streamer.decodeQueue.assign(MAX_STREAMED_ASSETS, 0);
+    streamer.uploadQueue.assign(MAX_STREAMED_ASSETS, 0);
+    streamer.readHead = streamer.readCount = 0;
+    streamer.decodeHead = streamer.decodeCount = 0;
+    streamer.uploadHead = streamer.uploadCount = 0;
+
+    // Tablero magenta: se nota en pantalla si algo nunca llega
+    if (renderer) {
+        Uint32 pixels[8 * 8];
+        for (int i = 0; i < 8 * 8; ++i) {
+            pixels[i] = ((i / 8 + i % 8) & 1) ? 0xFFFF00FFu : 0xFF200020u;
+        }
+        streamer.placeholder = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+        if (streamer.placeholder) {
+            SDL_UpdateTexture(streamer.placeholder, nullptr, pixels, 8 * sizeof(Uint32));
+        }
+    }
+    return true;
+}
+
+// Los hilos arrancan con el primer pedido: sin nada que cargar no cuestan
+// nada al iniciar
+static void startStreamerThreads(AssetStreamer& streamer) {
+    streamer.reader = std::thread(readerLoop, &streamer);
+    for (int i = 0; i < STREAM_DECODE_THREADS; ++i) {
+        streamer.decoders.emplace_back(decoderLoop, &streamer);
+    }
+}
+
+static void freeAsset(AssetStreamer& streamer, int slot) {
+    StreamedAsset& asset = streamer.assets[slot];
+    if (asset.texture) {
+        SDL_DestroyTexture(asset.texture);
+    }
+    SDL_FreeSurface(asset.surface);
+    unloadLevel(asset.level);
+    std::vector<unsigned char>().swap(asset.bytes);
+    asset.texture = nullptr;
+    asset.target = nullptr;
+    asset.surface = nullptr;
+    asset.data = nullptr;
+    asset.refs = 0;
+    removeDense(streamer.handles, denseIndex(streamer.handles, slotHandle(streamer, slot)));
+}
+
+void destroyAssetStreamer(AssetStreamer& streamer) {
+    {
+        std::lock_guard<std::mutex> lock(streamer.mutex);
+        streamer.quit = true;
+    }
+    streamer.wakeReader.notify_all();
+    streamer.wakeDecoders.notify_all();
+    if (streamer.reader.joinable()) {
+        streamer.reader.join();
+    }
+    for (std::thread& decoder : streamer.decoders) {
+        decoder.join();
+    }
+    streamer.decoders.clear();
+    // Sin hilos ya se puede liberar todo, incluso lo que quedo en las colas
+    while (streamer.handles.count > 0) {
+        freeAsset(streamer, static_cast<int>(handleAt(streamer.handles, 0) & 0xFFFF));
+    }
+    if (streamer.placeholder) {
+        SDL_DestroyTexture(streamer.placeholder);
+        streamer.placeholder = nullptr;
+    }
+}
+
+static Handle requestAsset(AssetStreamer& streamer, StreamKind kind, const char* name, SDL_Texture* target, const SDL_Rect& region) {
+    for (int i = 0; i < streamer.handles.count; ++i) {
+        Handle handle = handleAt(streamer.handles, i);
+        StreamedAsset& asset = streamer.assets[handle & 0xFFFF];
+        if (asset.refs > 0 && asset.kind == kind && asset.target == target && std::strcmp(asset.name, name) == 0) {
+            asset.refs++;
+            return handle;
+        }
+    }
+    if (std::strlen(name) >= STREAM_NAME_SIZE) {
+        std::cerr << "Asset name too long: " << name << std::endl;
+        return INVALID_HANDLE;
+    }
+    Handle handle = acquireHandle(streamer.handles);
+    if (handle == INVALID_HANDLE) {
+        return INVALID_HANDLE;
+    }
+    if (!streamer.reader.joinable()) {
+        startStreamerThreads(streamer);
+    }
+    int slot = static_cast<int>(handle & 0xFFFF);
+    StreamedAsset& asset = streamer.assets[slot];
+    asset.kind = kind;
+    asset.refs = 1;
+    std::strcpy(asset.name, name);
+    asset.target = target;
+    asset.region = region;
+    asset.format = SDL_PIXELFORMAT_ARGB8888;
+    if (target) {
+        SDL_QueryTexture(target, &asset.format, nullptr, nullptr, nullptr);
+    }
+    asset.uploadedRows = 0;
+    asset.requestedAt = SDL_GetPerformanceCounter();
+    asset.readMs = asset.decodeMs = asset.uploadMs = asset.readyMs = 0.0f;
+    streamer.stats.requested++;
+    streamer.stats.pending++;
+    {
+        std::lock_guard<std::mutex> lock(streamer.mutex);
+        asset.state = STREAM_QUEUED;
+        pushSlot(streamer.readQueue, streamer.readHead, streamer.readCount, slot);
+    }
+    streamer.wakeReader.notify_one();
+    return handle;
+}
+
+Handle requestTexture(AssetStreamer& streamer, const char* name) {
+    return requestAsset(streamer, STREAM_TEXTURE, name, nullptr, SDL_Rect());
+}
+
+Handle requestTextureRegion(AssetStreamer& streamer, const char* name, SDL_Texture* target, const SDL_Rect& region) {
+    return requestAsset(streamer, STREAM_TEXTURE, name, target, region);
+}
+
+Handle requestLevel(AssetStreamer& streamer, const char* name) {
+    return requestAsset(streamer, STREAM_LEVEL, name, nullptr, SDL_Rect());
+}
+
+void retainAsset(AssetStreamer& streamer, Handle handle) {
+    int slot = assetSlot(streamer, handle);
+    if (slot >= 0) {
+        streamer.assets[slot].refs++;
+    }
+}
+
+// Lo que sigue en vuelo se libera cuando sale por la cola de subida
+void releaseAsset(AssetStreamer& streamer, Handle handle) {
+    int slot = assetSlot(streamer, handle);
+    if (slot < 0 || streamer.assets[slot].refs == 0) {
+        return;
+    }
+    StreamState state = lockedState(streamer, slot);
+    if (--streamer.assets[slot].refs == 0 && (state == STREAM_READY || state == STREAM_FAILED)) {
+        freeAsset(streamer, slot);
+    }
+}
+
+StreamState assetState(const AssetStreamer& streamer, Handle handle) {
+    int slot = assetSlot(streamer, handle);
+    return slot >= 0 ? lockedState(streamer, slot) : STREAM_FAILED;
+}
+
+SDL_Texture* streamedTexture(const AssetStreamer& streamer, Handle handle) {
+    int slot = assetSlot(streamer, handle);
+    if (slot >= 0 && lockedState(streamer, slot) == STREAM_READY && streamer.assets[slot].texture) {
+        return streamer.assets[slot].texture;
+    }
+    return streamer.placeholder;
+}
+
+bool takeStreamedLevel(AssetStreamer& streamer, Handle handle, Level& level) {
+    int slot = assetSlot(streamer, handle);
+    if (slot < 0 || streamer.assets[slot].kind != STREAM_LEVEL || lockedState(streamer, slot) != STREAM_READY) {
+        return false;
+    }
+    std::swap(level, streamer.assets[slot].level);
+    return true;
+}
+
+// Un paso de subida; true cuando el asset termino
+static bool uploadStep(AssetStreamer& streamer, StreamedAsset& asset) {
+    if (asset.state == STREAM_FAILED || asset.kind == STREAM_LEVEL) {
+        return true;
+    }
+    SDL_Surface* surface = asset.surface;
+    if (!asset.target && !asset.texture) {
+        asset.texture = streamer.renderer ? SDL_CreateTexture(streamer.renderer, asset.format, SDL_TEXTUREACCESS_STATIC, surface->w, surface->h) : nullptr;
+        if (!asset.texture) {
+            std::cerr << "Error creating texture for " << asset.name << ": " << SDL_GetError() << std::endl;
+            asset.state = STREAM_FAILED;
+            return true;
+        }
+        SDL_SetTextureBlendMode(asset.texture, SDL_BLENDMODE_BLEND);
+        asset.region = {0, 0, surface->w, surface->h};
+    }
+    // Por franjas de filas, para repartir una imagen grande en varios frames
+    int rows = std::min(STREAM_UPLOAD_ROWS, surface->h - asset.uploadedRows);
+    SDL_Rect rect = {asset.region.x, asset.region.y + asset.uploadedRows, surface->w, rows};
+    const Uint8* pixels = static_cast<const Uint8*>(surface->pixels) + asset.uploadedRows * surface->pitch;
+    if (SDL_UpdateTexture(asset.target ? asset.target : asset.texture, &rect, pixels, surface->pitch) != 0) {
+        std::cerr << "Error uploading " << asset.name << ": " << SDL_GetError() << std::endl;
+        asset.state = STREAM_FAILED;
+        return true;
+    }
+    asset.uploadedRows += rows;
+    return asset.uploadedRows >= surface->h;
+}
+
+void pumpAssetStreamer(AssetStreamer& streamer, float budgetMs) {
+    PROFILE_ZONE("streaming");
+    StreamStats& stats = streamer.stats;
+    Uint64 start = SDL_GetPerformanceCounter();
+    stats.uploads = 0;
+    while (true) {
+        int slot;
+        {
+            // Se mira el primero sin sacarlo: puede necesitar varios pasos
+            std::lock_guard<std::mutex> lock(streamer.mutex);
+            if (streamer.uploadCount == 0) {
+                break;
+            }
+            slot = streamer.uploadQueue[streamer.uploadHead];
+        }
+        StreamedAsset& asset = streamer.assets[slot];
+        Uint64 stepStart = SDL_GetPerformanceCounter();
+        bool done = uploadStep(streamer, asset);
+        asset.uploadMs += msSince(stepStart);
+        stats.uploads++;
+        if (done) {
+            {
+                std::lock_guard<std::mutex> lock(streamer.mutex);
+                popSlot(streamer.uploadQueue, streamer.uploadHead, streamer.uploadCount);
+                if (asset.state != STREAM_FAILED) {
+                    asset.state = STREAM_READY;
+                }
+            }
+            SDL_FreeSurface(asset.surface);
+            asset.surface = nullptr;
+            asset.readyMs = msSince(asset.requestedAt);
+            bool failed = asset.state == STREAM_FAILED;
+            stats.pending--;
+            stats.ready += !failed;
+            stats.failed += failed;
+            stats.readyMsMax = std::max(stats.readyMsMax, asset.readyMs);
+            logEvent(LOG_ASSET_READY, slot, failed, asset.readyMs);
+            if (asset.refs == 0) {
+                freeAsset(streamer, slot);
+            }
+        }
+        if (msSince(start) >= budgetMs) {
+            break;
+        }
+    }
+    stats.uploadMs = stats.uploads > 0 ? msSince(start) : 0.0f;
+    if (stats.uploads > 0) {
+        stats.uploadMsMax = std::max(stats.uploadMsMax, stats.uploadMs);
+        stats.uploadMsTotal += stats.uploadMs;
+        stats.uploadFrames++;
+    }
+}
+
+// Carga sincronica (todo en el hilo principal, lo que se congelaria un
+// cambio de nivel) contra el streaming con presupuesto por frame
+void benchmarkStreaming(SDL_Renderer* renderer) {
+    const int imageCount = 24, imageSize = 256;
+    const int levelColumns = 400, levelRows = 250;
+    std::vector<std::string> images;
+    bool ok = true;
+    for (int i = 0; ok && i < imageCount; ++i) {
+        SDL_Surface* image = SDL_CreateRGBSurfaceWithFormat(0, imageSize, imageSize, 32, SDL_PIXELFORMAT_ARGB8888);
+        ok = image != nullptr;
+        for (int y = 0; ok && y < imageSize; ++y) {
+            Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(image->pixels) + y * image->pitch);
+            for (int x = 0; x < imageSize; ++x) {
+                row[x] = 0xFF000000u | ((x + i * 8) & 0xFF) << 16 | (y & 0xFF) << 8 | ((x ^ y) & 0xFF);
+            }
+        }
+        char name[64];
+        std::snprintf(name, sizeof(name), "bench_stream_%02d.bmp", i);
+        images.push_back(name);
+        ok = ok && SDL_SaveBMP(image, name) == 0;
+        SDL_FreeSurface(image);
+    }
+    const char* levelName = "bench_stream.lvl";
+    if (ok) {
+        std::vector<Block> blocks;
+        std::vector<BlockAttributes> attributes;
+        for (int r = 0; r < levelRows; ++r) {
+            for (int c = 0; c < levelColumns; ++c) {
+                blocks.push_back({{c * 64, r * 20, 64, 20}});
+                attributes.push_back(packBlockAttributes(1 + (r + c) % 3, BLOCK_NORMAL, 0));
+            }
+        }
+        const SDL_Color palette[] = {{0x00, 0xFF, 0x00, 0xFF}};
+        ok = writeLevel(levelName, blocks.data(), attributes.data(), static_cast<int>(blocks.size()), palette, 1,
+                        levelColumns * 64, levelRows * 20 * 4);
+    }
+
+    if (ok) {
+        // Todo en un solo frame, como hoy al iniciar
+        for (const std::string& name : images) {
+            dropFileCache(name.c_str());
+        }
+        dropFileCache(levelName);
+        Uint64 start = SDL_GetPerformanceCounter();
+        std::vector<SDL_Texture*> textures;
+        for (const std::string& name : images) {
+            SDL_Surface* surface = SDL_LoadBMP(name.c_str());
+            SDL_Surface* converted = surface ? SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+            SDL_Texture* texture = renderer && converted ? SDL_CreateTextureFromSurface(renderer, converted) : nullptr;
+            if (texture) {
+                textures.push_back(texture);
+            }
+            SDL_FreeSurface(converted);
+            SDL_FreeSurface(surface);
+        }
+        Level level;
+        loadLevel(level, levelName);
+        volatile int sink = 0;
+        for (int b = 0; b < level.count; ++b) {
+            sink = sink + level.blocks[b].rect.x;
+        }
+        float syncMs = msSince(start);
+        unloadLevel(level);
+        for (SDL_Texture* texture : textures) {
+            SDL_DestroyTexture(texture);
+        }
+
+        // Lo mismo en segundo plano; el "frame" sube con presupuesto y espera 16 ms
+        for (const std::string& name : images) {
+            dropFileCache(name.c_str());
+        }
+        dropFileCache(levelName);
+        AssetStreamer streamer;
+        initAssetStreamer(streamer, renderer, nullptr);
+        start = SDL_GetPerformanceCounter();
+        std::vector<Handle> handles;
+        for (const std::string& name : images) {
+            handles.push_back(requestTexture(streamer, name.c_str()));
+        }
+        Handle levelHandle = requestLevel(streamer, levelName);
+        float requestMs = msSince(start);
+        int frames = 0;
+        std::vector<float> frameUploadMs;
+        while (streamer.stats.pending > 0) {
+            pumpAssetStreamer(streamer, STREAM_UPLOAD_BUDGET_MS);
+            frameUploadMs.push_back(streamer.stats.uploadMs);
+            frames++;
+            SDL_Delay(16);
+        }
+        float allReadyMs = msSince(start);
+        Uint64 swapStart = SDL_GetPerformanceCounter();
+        bool swapped = takeStreamedLevel(streamer, levelHandle, level);
+        float swapMs = msSince(swapStart);
+        releaseAsset(streamer, levelHandle);
+        for (Handle handle : handles) {
+            releaseAsset(streamer, handle);
+        }
+        float releaseMs = msSince(swapStart) - swapMs;
+        unloadLevel(level);
+        std::sort(frameUploadMs.begin(), frameUploadMs.end());
+
+        std::printf("assets,sync_frame_ms,request_ms,frames,median_upload_ms,max_upload_ms,all_ready_ms,level_swap_ms,release_ms,failed\n");
+        std::printf("%d,%.3f,%.3f,%d,%.3f,%.3f,%.1f,%.4f,%.3f,%d%s\n", imageCount + 1, syncMs, requestMs, frames,
+                    frameUploadMs.empty() ? 0.0f : frameUploadMs[frameUploadMs.size() / 2], streamer.stats.uploadMsMax,
+                    allReadyMs, swapMs, releaseMs, streamer.stats.failed, swapped ? "" : " (level not ready)");
+        destroyAssetStreamer(streamer);
+    } else {
+        std::cerr << "Error creating the benchmark assets" << std::endl;
+    }
+
+    for (const std::string& name : images) {
+        std::remove(name.c_str());
+    }
+    std::remove(levelName);
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <SDL.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "asset_pack.h"
+#include "handle_pool.h"
+#include "level.h"
+
+const int MAX_STREAMED_ASSETS = 64;
+const int STREAM_DECODE_THREADS = 2;
+const int STREAM_NAME_SIZE = 128;
+const float STREAM_UPLOAD_BUDGET_MS = 1.0f; // Subida a texturas por frame
+const int STREAM_UPLOAD_ROWS = 32;          // Filas por llamada a SDL_UpdateTexture
+
+enum StreamKind : Uint8 {
+    STREAM_TEXTURE, // Imagen BMP -> textura
+    STREAM_LEVEL    // Nivel completo, listo para cambiarlo por el actual
+};
+
+enum StreamState : Uint8 {
+    STREAM_QUEUED,   // Esperando al hilo de lectura
+    STREAM_READ,     // Bytes en memoria, esperando a un decodificador
+    STREAM_DECODED,  // Esperando la subida en el hilo principal
+    STREAM_READY,
+    STREAM_FAILED
+};
+
+// Un asset en vuelo o cargado. Los hilos de fondo solo lo tocan mientras
+// esta en sus colas; el resto del tiempo es del hilo principal.
+struct StreamedAsset {
+    StreamKind kind = STREAM_TEXTURE;
+    StreamState state = STREAM_QUEUED;
+    int refs = 0;
+    char name[STREAM_NAME_SIZE] = {};
+
+    std::vector<unsigned char> bytes;    // Archivo suelto o entrada comprimida
+    const unsigned char* data = nullptr; // bytes, o la entrada sin comprimir en el mapeo del paquete
+    size_t size = 0;
+    SDL_Surface* surface = nullptr;
+
+    // Textura propia, o una region de `target` (por ejemplo un hueco del
+    // atlas de sprites) que tiene la imagen provisoria mientras tanto
+    SDL_Texture* texture = nullptr;
+    SDL_Texture* target = nullptr;
+    SDL_Rect region = {};
+    Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+    int uploadedRows = 0;
+
+    Level level;
+
+    Uint64 requestedAt = 0;
+    float readMs = 0.0f;
+    float decodeMs = 0.0f;
+    float uploadMs = 0.0f;
+    float readyMs = 0.0f; // Desde el pedido hasta poder usarlo
+};
+
+struct StreamStats {
+    int requested = 0;
+    int ready = 0;
+    int failed = 0;
+    int pending = 0;
+    int uploads = 0;          // Pasos de subida en el ultimo frame
+    float uploadMs = 0.0f;    // Costo de subida del ultimo frame
+    float uploadMsMax = 0.0f;
+    double uploadMsTotal = 0.0;
+    int uploadFrames = 0;     // Frames que subieron algo
+    float readyMsMax = 0.0f;
+};
+
+// Carga en segundo plano: un hilo lee (archivo suelto o paquete), los
+// decodificadores convierten a superficies o niveles y el hilo principal
+// sube a texturas con un presupuesto por frame. Los handles cuentan
+// referencias; al soltar el ultimo el asset se libera.
+struct AssetStreamer {
+    SDL_Renderer* renderer = nullptr;
+    const AssetPack* pack = nullptr;
+    SDL_Texture* placeholder = nullptr;
+
+    // Los datos van por ranura del handle, no en el orden denso del pool:
+    // los hilos guardan la ranura mientras trabajan
+    HandlePool handles;
+    std::vector<StreamedAsset> assets;
+
+    // Colas circulares de ranuras, protegidas por `mutex`
+    std::vector<int> readQueue;
+    std::vector<int> decodeQueue;
+    int readHead = 0, readCount = 0;
+    int decodeHead = 0, decodeCount = 0;
+    std::vector<int> uploadQueue;
+    int uploadHead = 0, uploadCount = 0;
+    bool quit = false;
+    mutable std::mutex mutex;
+    std::condition_variable wakeReader;
+    std::condition_variable wakeDecoders;
+    std::thread reader;
+    std::vector<std::thread> decoders;
+
+    StreamStats stats; // Solo el hilo principal
+};
+
+bool initAssetStreamer(AssetStreamer& streamer, SDL_Renderer* renderer, const AssetPack* pack);
+void destroyAssetStreamer(AssetStreamer& streamer);
+
+// Devuelven un handle con una referencia; el mismo nombre pedido dos veces
+// comparte el asset. INVALID_HANDLE si no hay ranuras libres.
+Handle requestTexture(AssetStreamer& streamer, const char* name);
+Handle requestTextureRegion(AssetStreamer& streamer, const char* name, SDL_Texture* target, const SDL_Rect& region);
+Handle requestLevel(AssetStreamer& streamer, const char* name);
+void retainAsset(AssetStreamer& streamer, Handle handle);
+void releaseAsset(AssetStreamer& streamer, Handle handle);
+
+StreamState assetState(const AssetStreamer& streamer, Handle handle);
+// La textura, o la provisoria hasta que llegue
+SDL_Texture* streamedTexture(const AssetStreamer& streamer, Handle handle);
+// Cambia el nivel cargado por `level` (el viejo queda en el asset y se
+// libera con el handle). false si todavia no esta listo.
+bool takeStreamedLevel(AssetStreamer& streamer, Handle handle, Level& level);
+
+// Una vez por frame en el hilo principal: sube lo decodificado hasta
+// gastar `budgetMs` (al menos un paso, para que todo avance)
+void pumpAssetStreamer(AssetStreamer& streamer, float budgetMs);
+
+void benchmarkStreaming(SDL_Renderer* renderer);
@@ -0,0 +1,176 @@
+#include "stress.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+void resetPeakResident() {
+#ifdef __linux__
+    // Escribir 5 en clear_refs reinicia VmHWM
+    FILE* file = std::fopen("/proc/self/clear_refs", "w");
+    if (file) {
+        std::fputs("5", file);
+        std::fclose(file);
+    }
+#endif
+}
+
+long long peakResidentKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+#ifdef __linux__
+    FILE* file = std::fopen("/proc/self/status", "r");
+    if (file) {
+        char line[128];
+        long long kb = -1;
+        while (std::fgets(line, sizeof(line), file)) {
+            if (std::sscanf(line, "VmHWM: %lld kB", &kb) == 1) {
+                break;
+            }
+        }
+        std::fclose(file);
+        if (kb >= 0) {
+            return kb;
+        }
+    }
+#endif
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // En bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+double percentile(std::vector<float>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void printStressResult(const StressResult& r) {
+    std::printf("%-20s %8d %12.1f %10.4f %10lld %8lld\n", r.name, r.ticks, r.ticksPerSecond, r.p99TickMs, r.peakRssKb, r.allocations);
+    std::fflush(stdout);
+}
+
+bool writeStressCsv(const char* path, const std::vector<StressResult>& results) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) {
+        std::fprintf(stderr, "Error opening %s\n", path);
+        return false;
+    }
+    std::fprintf(file, "scenario,ticks,ticks_per_second,p99_tick_ms,peak_rss_kb,allocations\n");
+    for (const StressResult& r : results) {
+        std::fprintf(file, "%s,%d,%.1f,%.4f,%lld,%lld\n", r.name, r.ticks, r.ticksPerSecond, r.p99TickMs, r.peakRssKb, r.allocations);
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Un escenario por linea, para que loadStressBaseline lo lea sin un parser de JSON
+static const char* const STRESS_JSON_LINE =
+    "    {\"name\": \"%s\", \"ticks\": %d, \"ticks_per_second\": %.1f, \"p99_tick_ms\": %.4f, \"peak_rss_kb\": %lld, \"allocations\": %lld}%s\n";
+static const char* const STRESS_JSON_SCAN =
+    " {\"name\": \"%31[^\"]\", \"ticks\": %d, \"ticks_per_second\": %lf, \"p99_tick_ms\": %lf, \"peak_rss_kb\": %lld, \"allocations\": %lld";
+
+bool writeStressJson(const char* path, const std::vector<StressResult>& results) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) {
+        std::fprintf(stderr, "Error opening %s\n", path);
+        return false;
+    }
+    std::fprintf(file, "{\n  \"scenarios\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const StressResult& r = results[i];
+        std::fprintf(file, STRESS_JSON_LINE, r.name, r.ticks, r.ticksPerSecond, r.p99TickMs, r.peakRssKb, r.allocations,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+    return true;
+}
+
+bool loadStressBaseline(const char* path, std::vector<StressResult>& baseline) {
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        std::fprintf(stderr, "Error opening baseline %s\n", path);
+        return false;
+    }
+    char line[512];
+    while (std::fgets(line, sizeof(line), file)) {
+        StressResult r = {};
+        if (std::sscanf(line, STRESS_JSON_SCAN, r.name, &r.ticks, &r.ticksPerSecond, &r.p99TickMs, &r.peakRssKb, &r.allocations) == 6) {
+            baseline.push_back(r);
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Empeora si `worse` supera a `base` por mas del umbral. Con una base en
+// cero (por ejemplo sin reservas) cualquier valor positivo es regresion.
+static bool regressed(const char* scenario, const char* metric, double base, double current, double worse, double threshold) {
+    bool bad = base > 0.0 ? worse > base * threshold : worse > 0.0;
+    if (bad) {
+        std::printf("REGRESSION %s %s: baseline %.4f, now %.4f\n", scenario, metric, base, current);
+    }
+    return bad;
+}
+
+// Busca `name` en `list`; nullptr si no esta
+static const StressResult* findStress(const std::vector<StressResult>& list, const char* name) {
+    for (const StressResult& s : list) {
+        if (std::strcmp(s.name, name) == 0) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+int compareStress(const std::vector<StressResult>& results, const std::vector<StressResult>& baseline, double threshold) {
+    int regressions = 0;
+    // Un escenario sin pareja quedaria sin control: cuenta como falla
+    for (const StressResult& b : baseline) {
+        if (!findStress(results, b.name)) {
+            std::printf("MISSING %s: in the baseline but not in the results\n", b.name);
+            regressions++;
+        }
+    }
+    for (const StressResult& r : results) {
+        const StressResult* base = findStress(baseline, r.name);
+        if (!base) {
+            std::printf("MISSING %s: no baseline entry, regenerate the baseline\n", r.name);
+            regressions++;
+            continue;
+        }
+        std::printf("%-20s ticks/s %12.1f -> %12.1f (%+6.1f%%) | p99 %8.4f -> %8.4f ms | rss %lld -> %lld kB\n", r.name,
+                    base->ticksPerSecond, r.ticksPerSecond, (r.ticksPerSecond / base->ticksPerSecond - 1.0) * 100.0,
+                    base->p99TickMs, r.p99TickMs, base->peakRssKb, r.peakRssKb);
+        // Menos ticks/s es peor; en las demas metricas, mas es peor
+        regressions += regressed(r.name, "ticks_per_second", base->ticksPerSecond, r.ticksPerSecond, base->ticksPerSecond - r.ticksPerSecond, threshold);
+        if (r.p99TickMs - base->p99TickMs > STRESS_P99_NOISE_MS) {
+            regressions += regressed(r.name, "p99_tick_ms", base->p99TickMs, r.p99TickMs, r.p99TickMs - base->p99TickMs, threshold);
+        }
+        regressions += regressed(r.name, "peak_rss_kb", static_cast<double>(base->peakRssKb), static_cast<double>(r.peakRssKb),
+                                 static_cast<double>(r.peakRssKb - base->peakRssKb), threshold);
+        regressions += regressed(r.name, "allocations", static_cast<double>(base->allocations), static_cast<double>(r.allocations),
+                                 static_cast<double>(r.allocations - base->allocations), threshold);
+    }
+    return regressions;
+}
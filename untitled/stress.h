@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+
+// Escenarios de estres de punta a punta: cada uno corre sin ventana un
+// numero fijo de ticks con semilla fija. Los resultados se guardan en
+// CSV/JSON y se comparan contra una linea base; una metrica que empeora
+// mas que el umbral cuenta como regresion.
+const double STRESS_DEFAULT_THRESHOLD = 0.15; // 15%
+const double STRESS_P99_NOISE_MS = 0.01;      // Diferencias de p99 menores son ruido del reloj
+
+struct StressResult {
+    char name[32];
+    int ticks;
+    double ticksPerSecond;
+    double p99TickMs;
+    long long peakRssKb;   // Pico de memoria residente durante el escenario
+    long long allocations; // Reservas en el heap despues del calentamiento
+};
+
+// El pico se reinicia entre escenarios donde el sistema lo permite
+// (Linux); en los demas es el pico del proceso hasta ese momento
+void resetPeakResident();
+long long peakResidentKb();
+
+double percentile(std::vector<float>& values, double fraction);
+void printStressResult(const StressResult& result);
+bool writeStressCsv(const char* path, const std::vector<StressResult>& results);
+bool writeStressJson(const char* path, const std::vector<StressResult>& results);
+bool loadStressBaseline(const char* path, std::vector<StressResult>& baseline);
+
+// Devuelve cuantas metricas empeoraron mas que `threshold` (0.15 = 15%),
+// mas los escenarios que estan solo en los resultados o solo en la base
+int compareStress(const std::vector<StressResult>& results, const std::vector<StressResult>& baseline, double threshold);
@@ -0,0 +1,135 @@
+#include "telemetry.h"
+#include <cstdio>
+#include <new>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// En Windows el nombre va sin la barra inicial de POSIX
+static void mappingName(char* out, int size, const char* name) {
+#ifdef _WIN32
+    std::snprintf(out, size, "Local\\%s", name[0] == '/' ? name + 1 : name);
+#else
+    std::snprintf(out, size, "%s%s", name[0] == '/' ? "" : "/", name);
+#endif
+}
+
+static void initTelemetryBlock(TelemetryBlock* block, Sint32 pid) {
+    new (block) TelemetryBlock();
+    block->version = TELEMETRY_VERSION;
+    block->size = sizeof(TelemetryBlock);
+    block->pid = pid;
+    std::memset(&block->values, 0, sizeof(block->values));
+    // magic al final: el lector no usa el bloque hasta verlo
+    block->magic.store(TELEMETRY_MAGIC, std::memory_order_release);
+}
+
+#ifdef _WIN32
+bool createTelemetry(Telemetry& telemetry, const char* name) {
+    mappingName(telemetry.name, sizeof(telemetry.name), name);
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(TelemetryBlock), telemetry.name);
+    if (!mapping) {
+        std::fprintf(stderr, "Error creating telemetry %s\n", telemetry.name);
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(TelemetryBlock));
+    if (!data) {
+        CloseHandle(mapping);
+        std::fprintf(stderr, "Error mapping telemetry %s\n", telemetry.name);
+        return false;
+    }
+    telemetry.block = static_cast<TelemetryBlock*>(data);
+    telemetry.mapping = mapping;
+    telemetry.owner = true;
+    initTelemetryBlock(telemetry.block, static_cast<Sint32>(GetCurrentProcessId()));
+    return true;
+}
+
+bool attachTelemetry(Telemetry& telemetry, const char* name) {
+    mappingName(telemetry.name, sizeof(telemetry.name), name);
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, telemetry.name);
+    if (!mapping) {
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(TelemetryBlock));
+    if (!data) {
+        CloseHandle(mapping);
+        return false;
+    }
+    telemetry.block = static_cast<TelemetryBlock*>(data);
+    telemetry.mapping = mapping;
+    telemetry.owner = false;
+    return true;
+}
+
+void closeTelemetry(Telemetry& telemetry) {
+    if (telemetry.block) {
+        if (telemetry.owner) {
+            telemetry.block->magic.store(0, std::memory_order_release);
+        }
+        UnmapViewOfFile(telemetry.block);
+        CloseHandle(telemetry.mapping);
+    }
+    telemetry = Telemetry();
+}
+#else
+bool createTelemetry(Telemetry& telemetry, const char* name) {
+    mappingName(telemetry.name, sizeof(telemetry.name), name);
+    int fd = shm_open(telemetry.name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        std::fprintf(stderr, "Error creating telemetry %s\n", telemetry.name);
+        return false;
+    }
+    if (ftruncate(fd, sizeof(TelemetryBlock)) != 0) {
+        close(fd);
+        shm_unlink(telemetry.name);
+        std::fprintf(stderr, "Error sizing telemetry %s\n", telemetry.name);
+        return false;
+    }
+    void* data = mmap(nullptr, sizeof(TelemetryBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(telemetry.name);
+        std::fprintf(stderr, "Error mapping telemetry %s\n", telemetry.name);
+        return false;
+    }
+    telemetry.block = static_cast<TelemetryBlock*>(data);
+    telemetry.owner = true;
+    initTelemetryBlock(telemetry.block, static_cast<Sint32>(getpid()));
+    return true;
+}
+
+// Proyeccion de solo lectura: un lector no puede alterar al juego
+bool attachTelemetry(Telemetry& telemetry, const char* name) {
+    mappingName(telemetry.name, sizeof(telemetry.name), name);
+    int fd = shm_open(telemetry.name, O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    void* data = mmap(nullptr, sizeof(TelemetryBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    telemetry.block = static_cast<TelemetryBlock*>(data);
+    telemetry.owner = false;
+    return true;
+}
+
+// El lector conserva su proyeccion despues del unlink y ve magic en 0
+void closeTelemetry(Telemetry& telemetry) {
+    if (telemetry.block) {
+        if (telemetry.owner) {
+            telemetry.block->magic.store(0, std::memory_order_release);
+            shm_unlink(telemetry.name);
+        }
+        munmap(telemetry.block, sizeof(TelemetryBlock));
+    }
+    telemetry = Telemetry();
+}
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+#include <SDL.h>
+#include <atomic>
+#include <cstring>
+
+// Contadores en vivo en memoria compartida, para monitorear instancias
+// largas sin leer el titulo de la ventana. El juego escribe un bloque por
+// frame protegido con un seqlock: nunca espera a los lectores, y los
+// lectores reintentan si la copia cambio mientras leian.
+const char* const TELEMETRY_DEFAULT_NAME = "/untitled_telemetry";
+const Uint32 TELEMETRY_MAGIC = 0x4D4C4554; // "TELM"
+const Uint32 TELEMETRY_VERSION = 1;
+
+struct TelemetryValues {
+    Uint64 frame;
+    Uint64 ticks;             // Actualizaciones de la simulacion desde el inicio
+    float frameMs;            // Trabajo del ultimo frame, sin la espera
+    float frameMsMax;         // Peor frame del ultimo segundo
+    float ticksPerSecond;
+    int fps;
+    int collisionTests;       // Pruebas de colision del ultimo tick
+    int blocksAlive;
+    int drawCalls;
+    int stateChanges;
+    int entities;
+    int particles;
+    int frameAllocations;
+    Sint64 heapAllocations;   // Total desde el inicio
+    Sint64 logDropped;
+};
+
+struct TelemetryBlock {
+    std::atomic<Uint32> magic;   // TELEMETRY_MAGIC cuando el bloque esta listo; 0 al cerrar
+    Uint32 version;
+    Uint32 size;
+    Sint32 pid;
+    alignas(64) std::atomic<Uint32> sequence; // Impar mientras se escribe
+    TelemetryValues values;
+};
+
+struct Telemetry {
+    TelemetryBlock* block = nullptr;
+    bool owner = false; // El juego crea y borra el bloque; el lector solo lo lee
+    char name[64] = {};
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+};
+
+bool createTelemetry(Telemetry& telemetry, const char* name);
+bool attachTelemetry(Telemetry& telemetry, const char* name); // Solo lectura
+void closeTelemetry(Telemetry& telemetry);
+
+// Escritor unico: marca la secuencia como impar, copia y la deja par
+inline void publishTelemetry(Telemetry& telemetry, const TelemetryValues& values) {
+    TelemetryBlock* block = telemetry.block;
+    if (!block || !telemetry.owner) {
+        return;
+    }
+    Uint32 sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&block->values, &values, sizeof(values));
+    block->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Copia consistente de los valores; false si el bloque no esta listo o
+// si el escritor lo cambio en todos los intentos
+inline bool readTelemetry(const Telemetry& telemetry, TelemetryValues& values, int attempts = 64) {
+    const TelemetryBlock* block = telemetry.block;
+    if (!block || block->magic.load(std::memory_order_acquire) != TELEMETRY_MAGIC) {
+        return false;
+    }
+    for (int i = 0; i < attempts; ++i) {
+        Uint32 before = block->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        std::memcpy(&values, &block->values, sizeof(values));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block->sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
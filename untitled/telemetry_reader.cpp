@@ -0,0 +1,78 @@
+// Lee en vivo la telemetria que publica el juego con --telemetry.
+//
+//   telemetry_reader                      una linea por segundo
+//   telemetry_reader --once               una sola lectura (para scripts)
+//   telemetry_reader --interval=250 NOMBRE
+//
+// Solo proyecta el bloque en modo lectura: el juego nunca espera al lector.
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "telemetry.h"
+
+static void printValues(const TelemetryBlock& block, const TelemetryValues& v) {
+    std::printf("pid %d | frame %llu | %.2f ms (max %.2f) | %.1f ticks/s | FPS %d | collisions %d | blocks %d"
+                " | draws %d states %d | entities %d particles %d | allocs %d (total %lld) | log drops %lld\n",
+                block.pid, static_cast<unsigned long long>(v.frame), v.frameMs, v.frameMsMax, v.ticksPerSecond, v.fps,
+                v.collisionTests, v.blocksAlive, v.drawCalls, v.stateChanges, v.entities, v.particles,
+                v.frameAllocations, static_cast<long long>(v.heapAllocations), static_cast<long long>(v.logDropped));
+    std::fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    const char* name = TELEMETRY_DEFAULT_NAME;
+    bool once = false;
+    int interval = 1000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if (std::strncmp(argv[i], "--interval=", 11) == 0) {
+            interval = std::max(10, std::atoi(argv[i] + 11));
+        } else {
+            name = argv[i];
+        }
+    }
+
+    Telemetry telemetry;
+    if (!attachTelemetry(telemetry, name)) {
+        std::fprintf(stderr, "No telemetry at %s (is the game running with --telemetry?)\n", name);
+        return 1;
+    }
+    if (telemetry.block->version != TELEMETRY_VERSION || telemetry.block->size != sizeof(TelemetryBlock)) {
+        std::fprintf(stderr, "Telemetry version %u does not match reader version %u\n", telemetry.block->version, TELEMETRY_VERSION);
+        closeTelemetry(telemetry);
+        return 1;
+    }
+
+    Uint64 lastFrame = ~0ull;
+    int stale = 0;
+    while (true) {
+        TelemetryValues values;
+        if (telemetry.block->magic.load(std::memory_order_acquire) != TELEMETRY_MAGIC) {
+            std::printf("Game exited\n");
+            break;
+        }
+        if (readTelemetry(telemetry, values)) {
+            // Si el frame no avanza el juego esta colgado o pausado
+            stale = values.frame == lastFrame ? stale + 1 : 0;
+            lastFrame = values.frame;
+            if (stale == 1) {
+                std::printf("Frame counter is not advancing\n");
+            }
+            printValues(*telemetry.block, values);
+        } else {
+            std::printf("Telemetry busy, retrying\n");
+        }
+        if (once) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+    }
+    closeTelemetry(telemetry);
+    return 0;
+}
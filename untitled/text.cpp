@@ -0,0 +1,185 @@
+#include "text.h"
+#include <cstdio>
+#include <cstring>
+
+// Fuente 5x7, una fila por byte (bit 4 = columna izquierda)
+static const char FONT_CHARS[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ:./-!%";
+static const Uint8 FONT_DATA[][GLYPH_HEIGHT] = {
+    {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000}, // ' '
+    {0b01110, 0b10001, 0b10011, 0b10101, 0b11001, 0b10001, 0b01110}, // 0
+    {0b00100, 0b01100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}, // 1
+    {0b01110, 0b10001, 0b00001, 0b00010, 0b00100, 0b01000, 0b11111}, // 2
+    {0b11110, 0b00001, 0b00001, 0b01110, 0b00001, 0b00001, 0b11110}, // 3
+    {0b00010, 0b00110, 0b01010, 0b10010, 0b11111, 0b00010, 0b00010}, // 4
+    {0b11111, 0b10000, 0b11110, 0b00001, 0b00001, 0b10001, 0b01110}, // 5
+    {0b00110, 0b01000, 0b10000, 0b11110, 0b10001, 0b10001, 0b01110}, // 6
+    {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b01000, 0b01000}, // 7
+    {0b01110, 0b10001, 0b10001, 0b01110, 0b10001, 0b10001, 0b01110}, // 8
+    {0b01110, 0b10001, 0b10001, 0b01111, 0b00001, 0b00010, 0b01100}, // 9
+    {0b01110, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}, // A
+    {0b11110, 0b10001, 0b10001, 0b11110, 0b10001, 0b10001, 0b11110}, // B
+    {0b01110, 0b10001, 0b10000, 0b10000, 0b10000, 0b10001, 0b01110}, // C
+    {0b11100, 0b10010, 0b10001, 0b10001, 0b10001, 0b10010, 0b11100}, // D
+    {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111}, // E
+    {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b10000}, // F
+    {0b01110, 0b10001, 0b10000, 0b10111, 0b10001, 0b10001, 0b01111}, // G
+    {0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}, // H
+    {0b01110, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}, // I
+    {0b00111, 0b00010, 0b00010, 0b00010, 0b00010, 0b10010, 0b01100}, // J
+    {0b10001, 0b10010, 0b10100, 0b11000, 0b10100, 0b10010, 0b10001}, // K
+    {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b11111}, // L
+    {0b10001, 0b11011, 0b10101, 0b10101, 0b10001, 0b10001, 0b10001}, // M
+    {0b10001, 0b10001, 0b11001, 0b10101, 0b10011, 0b10001, 0b10001}, // N
+    {0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}, // O
+    {0b11110, 0b10001, 0b10001, 0b11110, 0b10000, 0b10000, 0b10000}, // P
+    {0b01110, 0b10001, 0b10001, 0b10001, 0b10101, 0b10010, 0b01101}, // Q
+    {0b11110, 0b10001, 0b10001, 0b11110, 0b10100, 0b10010, 0b10001}, // R
+    {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110}, // S
+    {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100}, // T
+    {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}, // U
+    {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01010, 0b00100}, // V
+    {0b10001, 0b10001, 0b10001, 0b10101, 0b10101, 0b10101, 0b01010}, // W
+    {0b10001, 0b10001, 0b01010, 0b00100, 0b01010, 0b10001, 0b10001}, // X
+    {0b10001, 0b10001, 0b10001, 0b01010, 0b00100, 0b00100, 0b00100}, // Y
+    {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b11111}, // Z
+    {0b00000, 0b01100, 0b01100, 0b00000, 0b01100, 0b01100, 0b00000}, // :
+    {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b01100}, // .
+    {0b00001, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b10000}, // /
+    {0b00000, 0b00000, 0b00000, 0b11111, 0b00000, 0b00000, 0b00000}, // -
+    {0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00000, 0b00100}, // !
+    {0b11000, 0b11001, 0b00010, 0b00100, 0b01000, 0b10011, 0b00011}, // %
+};
+static const int GLYPH_COUNT = sizeof(FONT_DATA) / sizeof(FONT_DATA[0]);
+
+static Uint8 glyphLookup[128];
+
+static int glyphIndex(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return u < 128 ? glyphLookup[u] : 0;
+}
+
+bool createGlyphAtlas(SDL_Renderer* renderer, GlyphAtlas& atlas) {
+    for (int c = 0; c < 128; ++c) {
+        char upper = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : static_cast<char>(c);
+        const char* found = c ? std::strchr(FONT_CHARS, upper) : nullptr;
+        glyphLookup[c] = found ? static_cast<Uint8>(found - FONT_CHARS) : 0;
+    }
+
+    int rows = (GLYPH_COUNT + GLYPH_ATLAS_COLUMNS - 1) / GLYPH_ATLAS_COLUMNS;
+    atlas.width = GLYPH_ATLAS_COLUMNS * GLYPH_CELL_W;
+    atlas.height = rows * GLYPH_CELL_H;
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, atlas.width, atlas.height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return false;
+    }
+    SDL_FillRect(surface, NULL, 0x00FFFFFF); // Blanco transparente
+
+    // Hornear cada glifo en su celda; el color se aplica luego por vertice
+    for (int g = 0; g < GLYPH_COUNT; ++g) {
+        int cellX = (g % GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_W;
+        int cellY = (g / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_H;
+        for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+            Uint32* pixels = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + (cellY + row) * surface->pitch);
+            for (int col = 0; col < GLYPH_WIDTH; ++col) {
+                if (FONT_DATA[g][row] & (1 << (GLYPH_WIDTH - 1 - col))) {
+                    pixels[cellX + col] = 0xFFFFFFFF;
+                }
+            }
+        }
+    }
+
+    atlas.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!atlas.texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void destroyGlyphAtlas(GlyphAtlas& atlas) {
+    if (atlas.texture) {
+        SDL_DestroyTexture(atlas.texture);
+        atlas.texture = nullptr;
+    }
+}
+
+int addTextField(TextBatch& batch, int x, int y, int length, SDL_Color color) {
+    if (length > MAX_TEXT_FIELD) {
+        length = MAX_TEXT_FIELD;
+    }
+    TextField field;
+    field.x = x;
+    field.y = y;
+    field.first = batch.glyphs;
+    field.length = length;
+    field.color = color;
+    batch.fields.push_back(field);
+
+    // Quads vacios hasta que se asigne texto
+    for (int i = 0; i < length; ++i) {
+        int v = (batch.glyphs + i) * 4;
+        for (int k = 0; k < 4; ++k) {
+            batch.vertices.push_back({{0.0f, 0.0f}, {0, 0, 0, 0}, {0.0f, 0.0f}});
+        }
+        int quad[6] = {v, v + 1, v + 2, v + 2, v + 3, v};
+        batch.indices.insert(batch.indices.end(), quad, quad + 6);
+    }
+    batch.glyphs += length;
+    return static_cast<int>(batch.fields.size()) - 1;
+}
+
+static void layoutGlyph(TextBatch& batch, const GlyphAtlas& atlas, const TextField& field, int slot, char c) {
+    int g = glyphIndex(c);
+    float u0 = static_cast<float>((g % GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_W) / atlas.width;
+    float v0 = static_cast<float>((g / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_H) / atlas.height;
+    float u1 = u0 + static_cast<float>(GLYPH_WIDTH) / atlas.width;
+    float v1 = v0 + static_cast<float>(GLYPH_HEIGHT) / atlas.height;
+
+    float x0 = static_cast<float>(field.x + slot * GLYPH_CELL_W * TEXT_SCALE);
+    float y0 = static_cast<float>(field.y);
+    float x1 = x0 + GLYPH_WIDTH * TEXT_SCALE;
+    float y1 = y0 + GLYPH_HEIGHT * TEXT_SCALE;
+
+    SDL_Vertex* v = &batch.vertices[(field.first + slot) * 4];
+    v[0] = {{x0, y0}, field.color, {u0, v0}};
+    v[1] = {{x1, y0}, field.color, {u1, v0}};
+    v[2] = {{x1, y1}, field.color, {u1, v1}};
+    v[3] = {{x0, y1}, field.color, {u0, v1}};
+}
+
+void setText(TextBatch& batch, const GlyphAtlas& atlas, int field, const char* text) {
+    TextField& f = batch.fields[field];
+    bool ended = false;
+    for (int i = 0; i < f.length; ++i) {
+        if (!ended && text[i] == '\0') {
+            ended = true;
+        }
+        char c = ended ? ' ' : text[i];
+        if (f.text[i] == c) {
+            continue;
+        }
+        f.text[i] = c;
+        f.dirty = true;
+        layoutGlyph(batch, atlas, f, i, c);
+        batch.relayouts++;
+    }
+}
+
+void setNumber(TextBatch& batch, const GlyphAtlas& atlas, int field, int value) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%d", value);
+    setText(batch, atlas, field, buffer);
+}
+
+SDL_Rect textFieldBounds(const TextField& field) {
+    return {field.x, field.y, field.length * GLYPH_CELL_W * TEXT_SCALE, GLYPH_HEIGHT * TEXT_SCALE};
+}
+
+void renderText(RenderQueue& queue, const GlyphAtlas& atlas, const TextBatch& batch) {
+    if (batch.glyphs == 0) {
+        return;
+    }
+    queueGeometry(queue, LAYER_HUD, atlas.texture, SDL_BLENDMODE_BLEND, batch.vertices.data(), batch.glyphs * 4, batch.indices.data(), batch.glyphs * 6);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "render_queue.h"
+
+const int GLYPH_WIDTH = 5;
+const int GLYPH_HEIGHT = 7;
+const int GLYPH_CELL_W = GLYPH_WIDTH + 1;
+const int GLYPH_CELL_H = GLYPH_HEIGHT + 1;
+const int GLYPH_ATLAS_COLUMNS = 16;
+const int TEXT_SCALE = 2;
+const int MAX_TEXT_FIELD = 24;
+
+// Textura con todos los glifos, generada una vez al iniciar a partir de
+// la fuente de mapa de bits que va compilada en el ejecutable.
+struct GlyphAtlas {
+    SDL_Texture* texture = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
+// Un texto fijo en pantalla; ocupa `length` quads reservados en el lote.
+struct TextField {
+    int x = 0;
+    int y = 0;
+    int first = 0;
+    int length = 0;
+    char text[MAX_TEXT_FIELD + 1] = {};
+    SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF};
+    bool dirty = false;
+};
+
+// Lote de vertices de todo el texto del HUD, se dibuja con una sola llamada.
+// Solo se vuelven a generar los quads de los caracteres que cambian.
+struct TextBatch {
+    std::vector<TextField> fields;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    int glyphs = 0;
+    int relayouts = 0;
+};
+
+bool createGlyphAtlas(SDL_Renderer* renderer, GlyphAtlas& atlas);
+void destroyGlyphAtlas(GlyphAtlas& atlas);
+int addTextField(TextBatch& batch, int x, int y, int length, SDL_Color color);
+void setText(TextBatch& batch, const GlyphAtlas& atlas, int field, const char* text);
+void setNumber(TextBatch& batch, const GlyphAtlas& atlas, int field, int value);
+SDL_Rect textFieldBounds(const TextField& field);
+void renderText(RenderQueue& queue, const GlyphAtlas& atlas, const TextBatch& batch);